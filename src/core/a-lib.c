@@ -125,6 +125,7 @@ extern int Do_Callback(REBSER *obj, u32 name, RXIARG *args, RXIARG *result);
 		Trace_Level = 9999;
 		Trace_Flags = 1;
 	}
+	if (Main_Args.options & RO_PROFILE) Start_Profile(0);
 	return &Main_Args;
 }
 
@@ -861,7 +862,7 @@ RL_API REBUPT RL_Series(REBSER *series, REBCNT what)
 */
 {
 	switch (what) {
-	case RXI_SER_DATA: return (REBUPT)SERIES_DATA(series);
+	case RXI_SER_DATA: UNSHARE_SERIES(series); return (REBUPT)SERIES_DATA(series);
 	case RXI_SER_TAIL: return SERIES_TAIL(series);
 	case RXI_SER_LEFT: return SERIES_AVAIL(series);
 	case RXI_SER_SIZE: return SERIES_REST(series);
@@ -903,6 +904,7 @@ RL_API u32 RL_Set_Char(REBSER *series, u32 index, u32 chr)
 **			will be appended.
 */
 {
+	UNSHARE_SERIES(series);
 	if (index >= series->tail) {
 		index = series->tail;
 		EXPAND_SERIES_TAIL(series, 1);
@@ -959,6 +959,7 @@ static void Set_Option_File(REBCNT field, REBYTE* src, REBOOL dir )
 	// Thread locals:
 	Trace_Level = 0;
 	Saved_State = 0;
+	Trap_Quiet = FALSE;
 
 	Eval_Cycles = 0;
 	Eval_Dose = EVAL_DOSE;
@@ -1023,6 +1024,7 @@ static void Set_Option_File(REBCNT field, REBYTE* src, REBOOL dir )
 	// Thread locals:
 	Trace_Level = 0;
 	Saved_State = 0;
+	Trap_Quiet = FALSE;
 	Eval_Dose = EVAL_DOSE;
 	Eval_Limit = 0;
 	Eval_Signals = 0;
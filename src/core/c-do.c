@@ -33,6 +33,7 @@
 ***********************************************************************/
 
 #include "sys-core.h"
+#include "sys-int-funcs.h" //REB_I64_ADD_OF
 #include <stdio.h>
 
 REBNATIVE(do);  // Forward declaration for detection and special cases
@@ -483,7 +484,7 @@ void Trace_Arg(REBINT num, REBVAL *arg, REBVAL *path)
 
 	// Lookup the value of the variable:
 	if (IS_WORD(pvs.path)) {
-		pvs.value = Get_Var(pvs.path);
+		pvs.value = GET_VAR(pvs.path);
 		if (IS_UNSET(pvs.value)) Trap1(RE_NO_VALUE, pvs.path);
 		if (pvs.setval) {
 			pvs.setfrm = IS_OBJECT(pvs.value) ? VAL_OBJ_FRAME(pvs.value) : VAL_WORD_FRAME(pvs.path);
@@ -645,6 +646,81 @@ x*/	static REBINT Do_Args_Light(REBVAL *func, REBVAL *path, REBSER *block, REBCN
 #endif
 
 
+/***********************************************************************
+**
+*/	static REBVAL *Quick_Arg(REBSER *block, REBCNT index, REBFLG op)
+/*
+**		Return the value of an argument that needs no evaluation:
+**		an inert literal or a word holding a plain value, and not
+**		followed by an infix operator. Otherwise return zero and
+**		let Do_Next evaluate it.
+**
+**		It counts as an evaluation step like in Do_Next. When the
+**		count is exhausted or a signal is set, Do_Next handles it.
+**
+***********************************************************************/
+{
+	REBVAL *value = BLK_SKIP(block, index);
+	REBVAL *next;
+
+	if (Trace_Flags || Eval_Count <= 1 || Eval_Signals) return 0;
+
+	if (IS_WORD(value)) {
+		if (!VAL_WORD_FRAME(value)) return 0;
+		value = GET_VAR(value);
+		if (IS_UNSET(value) || ANY_FUNC(value) || IS_FRAME(value)) return 0;
+	}
+	else if (EVAL_TYPE(value) != ET_SELF) return 0;
+
+	if (!op) {
+		next = BLK_SKIP(block, index+1);
+		if (IS_WORD(next) && VAL_WORD_FRAME(next) && IS_OP(GET_VAR(next))) return 0;
+	}
+
+	Eval_Count--;
+	return value;
+}
+
+
+// Argument layout of a function (see Args_Layout):
+#define ARGL_DONE	((REBCNT)1 << 31)	// the layout was computed
+#define ARGL_PLAIN	((REBCNT)1 << 30)	// only evaluated words are before the first refinement
+#define ARGL_COUNT	0xffff				// number of args before the first refinement
+
+/***********************************************************************
+**
+*/	static REBCNT Args_Layout(REBSER *words)
+/*
+**		Return the argument layout of a function. It is computed
+**		on the first call and kept in the size field of the args
+**		series (not used by blocks otherwise).
+**
+**		A closure frame can extend the series, so the layout is
+**		checked to still end at a refinement or at the end.
+**
+***********************************************************************/
+{
+	REBCNT layout = words->size;
+	REBVAL *args = BLK_SKIP(words, 1);
+	REBCNT n;
+
+	if (layout & ARGL_DONE) {
+		n = layout & ARGL_COUNT;
+		if (n < SERIES_TAIL(words) && (IS_END(args + n) || IS_REFINEMENT(args + n)))
+			return layout;
+	}
+
+	layout = ARGL_DONE | ARGL_PLAIN;
+	for (n = 0; NOT_END(args) && !IS_REFINEMENT(args); args++, n++) {
+		if (!IS_WORD(args)) layout &= ~ARGL_PLAIN;
+	}
+	layout = (n > ARGL_COUNT) ? ARGL_DONE : (layout | n);
+
+	words->size = layout;
+	return layout;
+}
+
+
 /***********************************************************************
 **
 */	static REBINT Do_Args(REBCNT func_offset, REBVAL *path, REBSER *block, REBCNT index)
@@ -669,6 +745,8 @@ x*/	static REBINT Do_Args_Light(REBVAL *func, REBVAL *path, REBSER *block, REBCN
 	REBVAL *tos;
 	REBVAL *func;
 	REBOOL useArgs = TRUE;  // can be used by get-word function refinements to ignore values
+	REBFLG op;
+	REBCNT layout;
 
 	if ((dsp + 100) > (REBINT)SERIES_REST(DS_Series)) {
 		Expand_Stack(STACK_MIN);
@@ -676,7 +754,8 @@ x*/	static REBINT Do_Args_Light(REBVAL *func, REBVAL *path, REBSER *block, REBCN
 
 	func = DS_VALUE(func_offset);
 
-	if (IS_OP(func)) dsf--; // adjust for extra arg
+	op = IS_OP(func);
+	if (op) dsf--; // adjust for extra arg
 
 	// Get list of words:
 	words = VAL_FUNC_WORDS(func);
@@ -685,7 +764,7 @@ x*/	static REBINT Do_Args_Light(REBVAL *func, REBVAL *path, REBSER *block, REBCN
 	//Debug_Fmt("Args: %z", VAL_FUNC_ARGS(func));
 
 	// If func is operator, first arg is already on stack:
-	if (IS_OP(func)) {
+	if (op) {
 		//if (!TYPE_CHECK(args, VAL_TYPE(DS_VALUE(DSP))))
 		//	Trap3(RE_EXPECT_ARG, Func_Word(dsf), args, Of_Type(DS_VALUE(ds)));
 		args++;	 	// skip evaluation, but continue with type check
@@ -702,19 +781,49 @@ x*/	static REBINT Do_Args_Light(REBVAL *func, REBVAL *path, REBSER *block, REBCN
 	//O: while in R3 its: `[none none none]`
 	//O: I'm keeping R3's result as it would add too much processing to be compatible with Red;
 
+	// A call without refinements of a function having only evaluated
+	// args before its first refinement (most calls) needs no checks
+	// of the arg kinds and can stop at the known count:
+	if ((!path || IS_END(path)) && ((layout = Args_Layout(words)) & ARGL_PLAIN)) {
+		ds = dsp;
+		layout &= ARGL_COUNT;
+		if (op && layout) layout--;
+		for (; layout > 0; layout--, args++, ds++) {
+			if ((value = Quick_Arg(block, index, op))) {
+				index++;
+				DS_Base[ds] = *value;
+			}
+			else {
+				index = Do_Next(block, index, op);
+				if (index == END_FLAG) Trap2(RE_NO_ARG, Func_Word(dsf), args);
+				DS_Base[ds] = *DS_POP;
+				if (THROWN(DS_VALUE(ds))) {
+					*DS_TOP = *DS_VALUE(ds);
+					return index;
+				}
+			}
+			if (!TYPE_CHECK(args, VAL_TYPE(DS_VALUE(ds))))
+				Trap3(RE_EXPECT_ARG, Func_Word(dsf), args, Of_Type(DS_VALUE(ds)));
+		}
+		return index;
+	}
+
 	// Go thru the word list args:
 	ds = dsp;
 	for (; NOT_END(args); args++, ds++) {
 
-		func = DS_VALUE(func_offset); //DS_Base could be changed (data stack expansion)
-
 		//if (Trace_Flags) Trace_Arg(ds - dsp, args, path);
 
 		// Process each formal argument:
 		switch (VAL_TYPE(args)) {
 
 		case REB_WORD:		// WORD - Evaluate next value
-			index = Do_Next(block, index, IS_OP(func));
+			if ((value = Quick_Arg(block, index, op))) {
+				index++;
+				if (useArgs) DS_Base[ds] = *value;
+				break;
+			}
+			index = Do_Next(block, index, op);
 			// THROWN is handled after the switch.
 			if (index == END_FLAG) Trap2(RE_NO_ARG, Func_Word(dsf), args);
 			if (useArgs) DS_Base[ds] = *DS_POP; else DS_DROP;
@@ -724,7 +833,7 @@ x*/	static REBINT Do_Args_Light(REBVAL *func, REBVAL *path, REBSER *block, REBCN
 			if (index < BLK_LEN(block)) {
 				value = BLK_SKIP(block, index);
 				if (IS_PAREN(value) || IS_GET_WORD(value) || IS_GET_PATH(value)) {
-					index = Do_Next(block, index, IS_OP(func));
+					index = Do_Next(block, index, op);
 					// THROWN is handled after the switch.
 					if (useArgs) DS_Base[ds] = *DS_POP; else DS_DROP;
 				}
@@ -849,6 +958,7 @@ more_get_path:
 		Eval_Count = Eval_Dose;
 		if (Eval_Limit != 0 && Eval_Cycles > Eval_Limit)
 			Check_Security(SYM_EVAL, POL_EXEC, 0);
+		if (Profile_Interval) Check_Profile();
 	}
 
 	if (!(Eval_Signals & Eval_Sigmask)) return;
@@ -882,6 +992,88 @@ more_get_path:
 }
 
 
+/***********************************************************************
+**
+*/	static REBFLG Do_Quick_Op(REBVAL *func, REBVAL *arg)
+/*
+**		Evaluate common integer and decimal operators in place,
+**		without pushing a function frame. The first argument is
+**		on top of stack and arg is the next value in the block.
+**		Only a literal number or a word holding one is handled, so
+**		nothing needs to be evaluated for the second argument.
+**
+**		Returns FALSE if the generic operator call must be used
+**		(other types, other operators, overflow or NaN results).
+**
+***********************************************************************/
+{
+	REBVAL *val = DS_TOP;
+	REBINT act;
+	REBI64 n;
+	REBDEC d;
+
+	if (IS_WORD(arg)) {
+		if (!VAL_WORD_FRAME(arg)) return FALSE;
+		arg = GET_VAR(arg);
+	}
+	if (VAL_TYPE(val) != VAL_TYPE(arg)) return FALSE;
+
+	// Map comparison natives to their action number:
+	if (VAL_GET_EXT(func) == REB_ACTION) act = VAL_FUNC_ACT(func);
+	else if (VAL_GET_EXT(func) != REB_NATIVE) return FALSE;
+	else if (VAL_FUNC_CODE(func) == &N_lesserq) act = -1;
+	else if (VAL_FUNC_CODE(func) == &N_greaterq) act = -2;
+	else if (VAL_FUNC_CODE(func) == &N_lesser_or_equalq) act = -3;
+	else if (VAL_FUNC_CODE(func) == &N_greater_or_equalq) act = -4;
+	else if (VAL_FUNC_CODE(func) == &N_equalq) act = -5;
+	else if (VAL_FUNC_CODE(func) == &N_not_equalq) act = -6;
+	else return FALSE;
+
+	if (IS_INTEGER(val)) {
+		switch (act) {
+		case A_ADD:
+			if (REB_I64_ADD_OF(VAL_INT64(val), VAL_INT64(arg), &n)) return FALSE;
+			break;
+		case A_SUBTRACT:
+			if (REB_I64_SUB_OF(VAL_INT64(val), VAL_INT64(arg), &n)) return FALSE;
+			break;
+		case A_MULTIPLY:
+			if (REB_I64_MUL_OF(VAL_INT64(val), VAL_INT64(arg), &n)) return FALSE;
+			break;
+		case -1: SET_LOGIC(val, VAL_INT64(val) <  VAL_INT64(arg)); return TRUE;
+		case -2: SET_LOGIC(val, VAL_INT64(val) >  VAL_INT64(arg)); return TRUE;
+		case -3: SET_LOGIC(val, VAL_INT64(val) <= VAL_INT64(arg)); return TRUE;
+		case -4: SET_LOGIC(val, VAL_INT64(val) >= VAL_INT64(arg)); return TRUE;
+		case -5: SET_LOGIC(val, VAL_INT64(val) == VAL_INT64(arg)); return TRUE;
+		case -6: SET_LOGIC(val, VAL_INT64(val) != VAL_INT64(arg)); return TRUE;
+		default: return FALSE;
+		}
+		SET_INTEGER(val, n);
+		return TRUE;
+	}
+
+	if (IS_DECIMAL(val)) {
+		// Equality is left to CT_Decimal (it is tolerant).
+		switch (act) {
+		case A_ADD:      d = VAL_DECIMAL(val) + VAL_DECIMAL(arg); break;
+		case A_SUBTRACT: d = VAL_DECIMAL(val) - VAL_DECIMAL(arg); break;
+		case A_MULTIPLY: d = VAL_DECIMAL(val) * VAL_DECIMAL(arg); break;
+		// Same forms as the natives use (matters for NaN):
+		case -1: SET_LOGIC(val, !(VAL_DECIMAL(val) >= VAL_DECIMAL(arg))); return TRUE;
+		case -2: SET_LOGIC(val,   VAL_DECIMAL(val) >  VAL_DECIMAL(arg));  return TRUE;
+		case -3: SET_LOGIC(val, !(VAL_DECIMAL(val) >  VAL_DECIMAL(arg))); return TRUE;
+		case -4: SET_LOGIC(val,   VAL_DECIMAL(val) >= VAL_DECIMAL(arg));  return TRUE;
+		default: return FALSE;
+		}
+		if (!FINITE(d)) return FALSE;
+		SET_DECIMAL(val, d);
+		return TRUE;
+	}
+
+	return FALSE;
+}
+
+
 /***********************************************************************
 **
 */	REBCNT Do_Next(REBSER *block, REBCNT index, REBFLG op)
@@ -895,6 +1087,11 @@ more_get_path:
 **		Op indicates infix operator is being evaluated (precedence);
 **		The value (or error) is placed on top of the data stack.
 **
+**		There is no compiled form of blocks. A block can be modified,
+**		its words rebound in place and any word redefined (even as an
+**		operator) between two steps, so each step dispatches on the
+**		value and looks words up through their current binding.
+**
 ***********************************************************************/
 {
 	REBVAL *value;
@@ -917,7 +1114,8 @@ reval:
 	switch (EVAL_TYPE(value)) {
 
 	case ET_WORD:
-		value = Get_Var(word = value);
+		word = value;
+		value = GET_VAR(word);
 		if (IS_UNSET(value)) Trap1(RE_NO_VALUE, word);
 		if (ANY_FUNC(value)) goto reval;
 		DS_PUSH(value);
@@ -995,6 +1193,11 @@ eval_func2:
 		// datatype is stored in the extended flags part of the value.
 		if (!word) word = ROOT_NONAME;
 		if (DSP <= 0 || index == 0) Trap1(RE_NO_OP_ARG, word);
+		if (!(Trace_Flags || Call_Stats_Active || Profile_Interval)
+			&& Do_Quick_Op(value, BLK_SKIP(block, index+1))) {
+			index += 2;
+			break;
+		}
 		ftype = VAL_GET_EXT(value) - REB_NATIVE;
 		dsf = Push_Func(TRUE, block, index, VAL_WORD_SYM(word), value); // TOS has first arg
 		DS_PUSH(DS_VALUE(dsf)); // Copy prior to first argument
@@ -1045,7 +1248,7 @@ eval_func2:
 		break;
 
 	case ET_GET_WORD:
-		DS_PUSH(Get_Var(value));
+		DS_PUSH(GET_VAR(value));
 		index++;
 		break;
 
@@ -1071,7 +1274,7 @@ eval_func2:
 	// If normal eval (not higher precedence of infix op), check for op:
 	if (!op) {
 		value = BLK_SKIP(block, index);
-		if (IS_WORD(value) && VAL_WORD_FRAME(value) && IS_OP(Get_Var(value)))
+		if (IS_WORD(value) && VAL_WORD_FRAME(value) && IS_OP(GET_VAR(value)))
 			goto reval;
 	}
 
@@ -1156,10 +1359,12 @@ eval_func2:
 
 /***********************************************************************
 **
-*/	REBFLG Try_Block(REBSER *block, REBCNT index)
+*/	REBFLG Try_Block(REBSER *block, REBCNT index, REBFLG quiet)
 /*
 **		Evaluate a block from the index position specified in the value.
 **		TOS+1 holds the result.
+**		If quiet is set, the caller will discard the error, so errors
+**		trapped in the block do not build an error object.
 **
 ***********************************************************************/
 {
@@ -1176,6 +1381,7 @@ eval_func2:
 		return TRUE;
 	}
 	SET_STATE(state, Saved_State);
+	Trap_Quiet = quiet;
 
 	tos = 0;
 	while (index < BLK_LEN(block)) {
@@ -50,6 +50,10 @@
 
 		Catch_Error can be extended to provide a debugging breakpoint
 		for examining the call trace and context frames on the stack.
+
+		When the innermost catch discards the error (ATTEMPT sets
+		Trap_Quiet), the TrapN() functions skip building the object
+		and its backtrace and throw the error template instead.
 */
 /*
 
@@ -144,6 +148,21 @@ static REBOL_STATE Top_State; // Boot var: holds error state during boot
 }
 
 
+/***********************************************************************
+**
+*/	void Throw_Quiet(REBCNT num)
+/*
+**		Throw an error to a handler that will discard it. Only the
+**		error number is set; the object is the shared template.
+**
+***********************************************************************/
+{
+	if (!Saved_State) Crash(RP_NO_SAVED_STATE);
+	SET_ERROR(TASK_THIS_ERROR, num, VAL_OBJ_FRAME(ROOT_ERROBJ));
+	LONG_JUMP(*Saved_State, 1);
+}
+
+
 /***********************************************************************
 **
 */	void Throw_Break(REBVAL *val)
@@ -509,6 +528,7 @@ invalid_id:
 /*
 ***********************************************************************/
 {
+	if (Trap_Quiet && !Trace_Level) Throw_Quiet(num);
 	Throw_Error(Make_Error(num, 0, 0, 0));
 	DEAD_END;
 }
@@ -520,6 +540,7 @@ invalid_id:
 /*
 ***********************************************************************/
 {
+	if (Trap_Quiet && !Trace_Level) Throw_Quiet(num);
 	Throw_Error(Make_Error(num, arg1, 0, 0));
 	DEAD_END;
 }
@@ -531,6 +552,7 @@ invalid_id:
 /*
 ***********************************************************************/
 {
+	if (Trap_Quiet && !Trace_Level) Throw_Quiet(num);
 	Throw_Error(Make_Error(num, arg1, arg2, 0));
 	DEAD_END;
 }
@@ -542,6 +564,7 @@ invalid_id:
 /*
 ***********************************************************************/
 {
+	if (Trap_Quiet && !Trace_Level) Throw_Quiet(num);
 	Throw_Error(Make_Error(num, arg1, arg2, arg3));
 	DEAD_END;
 }
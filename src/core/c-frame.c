@@ -89,6 +89,23 @@
 
 #define CHECK_BIND_TABLE
 
+// Word lookup cache used by Find_Word_Index (direct mapped).
+// Entries are keyed by the word list series (the frame's shape) and
+// the symbol, and are validated on every hit, so a stale entry left
+// by a recycled or expanded word list is harmless.
+#define WORD_CACHE_SIZE 512	// must be power of 2
+
+typedef struct {
+	REBSER *words;
+	REBCNT sym;
+	REBCNT index;
+} REB_WORD_CACHE;
+
+static REB_WORD_CACHE Word_Cache[WORD_CACHE_SIZE];
+
+#define WORD_CACHE_SLOT(w, s) \
+	(&Word_Cache[(((REBUPT)(w) >> 4) ^ (s) * 31) & (WORD_CACHE_SIZE - 1)])
+
 /***********************************************************************
 **
 */	void Check_Bind_Table(void)
@@ -471,6 +488,7 @@
 /*
 **      Create an object from a parent object and a spec block.
 **		The words within the resultant object are not bound.
+**		Strings of the parent are shared copy-on-write.
 **
 ***********************************************************************/
 {
@@ -480,7 +498,7 @@
 	PG_Reb_Stats->Objects++;
 
 	if (!block || IS_END(block)) {
-		object = parent ? Copy_Block_Values(parent, 0, SERIES_TAIL(parent), TS_CLONE) : Make_Frame(0);
+		object = parent ? Copy_Block_Values(parent, 0, SERIES_TAIL(parent), TS_CLONE_SHARED) : Make_Frame(0);
 	} else {
 		words = Collect_Frame(BIND_ONLY, parent, block); // GC safe
 		object = Create_Frame(words, 0); // GC safe
@@ -491,7 +509,7 @@
 #endif
 			// Copy parent values and deep copy blocks and strings:
 			COPY_VALUES(FRM_VALUES(parent)+1, FRM_VALUES(object)+1, SERIES_TAIL(parent) - 1);
-			Copy_Deep_Values(object, 1, SERIES_TAIL(object), TS_CLONE);
+			Copy_Deep_Values(object, 1, SERIES_TAIL(object), TS_CLONE_SHARED);
 		}
 	}
 
@@ -942,7 +960,7 @@
 
 /***********************************************************************
 **
-*/  static void Bind_Relative_Words(REBSER *frame, REBSER *block)
+*/  static void Bind_Relative_Words(REBSER *frame, REBSER *block, REBINT *binds)
 /*
 **      Recursive function for relative function word binding.
 **
@@ -957,14 +975,14 @@
 	for (; NOT_END(value); value++) {
 		if (ANY_WORD(value)) {
 			// Is the word (canon sym) found in this frame?
-			if (NZ(n = WORDS_HEAD(Bind_Table)[VAL_WORD_CANON(value)])) {
+			if (NZ(n = binds[VAL_WORD_CANON(value)])) {
 				// Word is in frame, bind it:
 				VAL_WORD_INDEX(value) = n;
 				VAL_WORD_FRAME(value) = frame; // func body
 			}
 		}
 		else if (ANY_BLOCK_OR_MAP(value))
-			Bind_Relative_Words(frame, VAL_SERIES(value));
+			Bind_Relative_Words(frame, VAL_SERIES(value), binds);
 	}
 }
 
@@ -977,6 +995,11 @@
 **      To indicate the relative nature of the index, it is set to
 **		a negative offset.
 **
+**		Only the arg entries of the Bind_Table are set and reset, so
+**		the cost is one walk of the body with a direct index per word.
+**		Nested blocks are bound now, as they are reachable (body-of,
+**		passed as values) before they are evaluated.
+**
 **		words: VAL_FUNC_ARGS(func)
 **		frame: VAL_FUNC_ARGS(func)
 **		block: block to bind
@@ -989,6 +1012,9 @@
 
 	args = BLK_SKIP(words, 1);
 
+	// No args or locals (e.g. DOES), so nothing in the body can bind:
+	if (IS_END(args)) return;
+
 	CHECK_BIND_TABLE;
 
 	//Dump_Block(words);
@@ -997,7 +1023,7 @@
 	for (index = 1; NOT_END(args); args++, index++)
 		binds[VAL_BIND_CANON(args)] = -index;
 
-	Bind_Relative_Words(frame, block);
+	Bind_Relative_Words(frame, block, binds);
 
 	// Reset binding table:
 	for (args = BLK_SKIP(words, 1); NOT_END(args); args++)
@@ -1092,19 +1118,38 @@
 **      Search a frame looking for the given word symbol.
 **      Return the frame index for a word. Locate it by matching
 **      the canon word identifiers. Return 0 if not found.
+**      Hits are cached per word list, so repeated obj/field
+**      lookups do not rescan wide objects.
 **
 ***********************************************************************/
 {
-	REBCNT len = SERIES_TAIL(FRM_WORD_SERIES(frame));
-	REBVAL *word = FRM_WORDS(frame) + 1;
+	REBSER *words = FRM_WORD_SERIES(frame);
+	REBCNT len = SERIES_TAIL(words);
+	REB_WORD_CACHE *slot = WORD_CACHE_SLOT(words, sym);
+	REBVAL *word;
 	REBCNT n;
 	REBCNT s;
 
 	s = SYMBOL_TO_CANON(sym); // always compare to CANON sym
 
-	for (n = 1; n < len; n++, word++)
+	// Words are unique (by canon) in a frame, so a match at the
+	// cached index is the same result the scan would give:
+	if (slot->words == words && slot->sym == sym && slot->index < len) {
+		n = slot->index;
+		word = BLK_SKIP(words, n);
 		if (sym == VAL_BIND_SYM(word) || s == VAL_BIND_CANON(word))
 			return (!always && VAL_GET_OPT(word, OPTS_HIDE)) ? 0 : n;
+	}
+
+	word = BLK_SKIP(words, 1);
+
+	for (n = 1; n < len; n++, word++)
+		if (sym == VAL_BIND_SYM(word) || s == VAL_BIND_CANON(word)) {
+			slot->words = words;
+			slot->sym = sym;
+			slot->index = n;
+			return (!always && VAL_GET_OPT(word, OPTS_HIDE)) ? 0 : n;
+		}
 
 	return 0;
 }
@@ -301,12 +301,16 @@
 {
 	REBVAL *ds;
 	REBINT n;
+	REBI64 prof = 0;
+	REBCNT stat = 0;
 #ifdef DEBUGGING
 	REBYTE *fname = Get_Word_Name(DSF_WORD(DSF));	// for DEBUG
 	Debug_Str(fname);
 #endif
 
 	Eval_Natives++;
+	if (Call_Stats_Active) stat = Enter_Call_Stats();
+	if (Profile_Interval) prof = Profile_Enter();
 
 	if (NZ(n = VAL_FUNC_CODE(func)(DS_RETURN))) {
 		ds = DS_RETURN;
@@ -342,6 +346,8 @@
 			break;
 		}
 	}
+	if (prof) Profile_Leave(prof);
+	if (stat) Leave_Call_Stats(stat);
 }
 
 
@@ -403,6 +409,8 @@
 {
 	REBVAL *ds = DS_RETURN;
 	REBCNT type = VAL_TYPE(D_ARG(1));
+	REBI64 prof = 0;
+	REBCNT stat = 0;
 
 	Eval_Natives++;
 
@@ -415,7 +423,11 @@
 		return;
 	}
 
+	if (Call_Stats_Active) stat = Enter_Call_Stats();
+	if (Profile_Interval) prof = Profile_Enter();
 	Do_Act(D_RET, type, VAL_FUNC_ACT(func));
+	if (prof) Profile_Leave(prof);
+	if (stat) Leave_Call_Stats(stat);
 }
 
 
@@ -427,15 +439,18 @@
 {
 	REBVAL *result;
 	REBVAL *ds;
+	REBCNT stat = 0;
 #ifdef DEBUGGING
 	REBYTE *name = Get_Word_Name(DSF_WORD(DSF));
 #endif
 
 	Eval_Functions++;
+	if (Call_Stats_Active) stat = Enter_Call_Stats();
 
 	//Dump_Block(VAL_FUNC_BODY(func));
 	result = Do_Blk(VAL_FUNC_BODY(func), 0);
 	ds = DS_RETURN;
+	if (stat) Leave_Call_Stats(stat);
 
 	if (IS_ERROR(result) && IS_RETURN(result)) {
 		// Value below is kept safe from GC because no-allocation is
@@ -462,8 +477,10 @@
 	REBSER *frame;
 	REBVAL *result;
 	REBVAL *ds;
+	REBCNT stat = 0;
 
 	Eval_Functions++;
+	if (Call_Stats_Active) stat = Enter_Call_Stats();
 	//DISABLE_GC;
 
 	// Clone the body of the function to allow rebinding to it:
@@ -480,6 +497,7 @@
 	SET_OBJECT(ds, body); // keep it GC safe
 	result = Do_Blk(body, 0); // GC-OK - also, result returned on DS stack
 	ds = DS_RETURN;
+	if (stat) Leave_Call_Stats(stat);
 
 	if (IS_ERROR(result) && IS_RETURN(result)) {
 		// Value below is kept safe from GC because no-allocation is
@@ -186,6 +186,9 @@
 			Halt_Code(RE_HALT, 0); // Throws!
 		}
 
+		// Expire due timers (adds their events):
+		Fire_Timers();
+
 		// Process any waiting events:
 		if ((result = Awake_System(ports, only)) > 0) return TRUE;
 
@@ -216,6 +219,10 @@
 			}
 		}
 
+		// Do not sleep past the next timer deadline:
+		if ((result = Next_Timer_Delay()) >= 0 && (REBCNT)result < wt)
+			wt = result > 0 ? result : 1;
+
 		// printf("base: %ull res: %u wt: %u old_time: %i time: %u timeout: %u\n", base, res, wt, old_time, time, timeout);
 
 		// Wait for events or time to expire:
@@ -591,6 +598,7 @@ SCHEME_ACTIONS *Scheme_Actions;	// Initial Global (not threaded)
 	Init_File_Scheme();
 	Init_Dir_Scheme();
 	Init_Event_Scheme();
+	Init_Timer_Scheme();
 	Init_TCP_Scheme();
 	Init_UDP_Scheme();
 	Init_DNS_Scheme();
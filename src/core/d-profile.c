@@ -0,0 +1,634 @@
+/***********************************************************************
+**
+**  REBOL [R3] Language Interpreter and Run-time Environment
+**
+**  Copyright 2012 REBOL Technologies
+**  Copyright 2012-2026 Rebol Open Source Contributors
+**  REBOL is a trademark of REBOL Technologies
+**
+**  Licensed under the Apache License, Version 2.0 (the "License");
+**  you may not use this file except in compliance with the License.
+**  You may obtain a copy of the License at
+**
+**  http://www.apache.org/licenses/LICENSE-2.0
+**
+**  Unless required by applicable law or agreed to in writing, software
+**  distributed under the License is distributed on an "AS IS" BASIS,
+**  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+**  See the License for the specific language governing permissions and
+**  limitations under the License.
+**
+************************************************************************
+**
+**  Module:  d-profile.c
+**  Summary: sampling profiler and call statistics
+**  Section: debug
+**  Notes:
+**
+**	Sampling is driven by the evaluator's signal poll (Do_Signals).
+**	While profiling, the evaluation dose is lowered and each poll
+**	checks the clock. When the sampling interval elapsed, the function
+**	names of the DSF call stack are recorded together with the time
+**	passed since the previous sample (so samples are weighted).
+**
+**	Natives and actions which run longer than the interval (and do not
+**	evaluate any code themselves) take their sample when they return,
+**	while their frame is still on the stack. Time spent in the garbage
+**	collector is recorded with an extra "gc" frame at the stack top.
+**
+**	When the profiler is off, the only cost is a test of the
+**	Profile_Interval variable in Do_Signals, Do_Native and Do_Action.
+**
+**	Call statistics (CALL-STATS native) are described further below.
+**
+***********************************************************************/
+
+#include "sys-core.h"
+
+#define PROFILE_DOSE       500    // evaluations between clock checks
+#define PROFILE_INTERVAL   1000   // default sampling interval (microseconds)
+#define MAX_PROFILE_DEPTH  256    // deeper stacks keep only the root side
+
+typedef struct rebol_profile_stack {
+	REBCNT offset;      // position of the stack symbols in Prof_Syms
+	REBCNT depth;       // number of symbols
+	REBCNT hash;
+	REBI64 samples;
+	REBI64 time;        // microseconds
+} REBPST;
+
+static REBSER *Prof_Syms;      // symbols of all recorded stacks (root first)
+static REBSER *Prof_Stacks;    // REBPST records
+static REBSER *Prof_Hash;      // stack hash -> record index + 1
+static REBI64  Prof_Last;      // time of the last sample
+static REBI64  Prof_Samples;   // number of samples taken
+static REBI64  Prof_Time;      // sum of all sample times
+static REBI64  Prof_GC_Time;   // time spent in Recycle
+static REBINT  Prof_Saved_Dose;
+
+
+/***********************************************************************
+**
+*/	static void Set_Eval_Dose(REBINT dose)
+/*
+**		Change the evaluation dose without skewing Eval_Cycles.
+**
+***********************************************************************/
+{
+	Eval_Cycles += Eval_Dose - Eval_Count;
+	Eval_Dose = Eval_Count = dose;
+}
+
+
+/***********************************************************************
+**
+*/	static void Rehash_Profile(REBCNT size)
+/*
+***********************************************************************/
+{
+	REBPST *stk = (REBPST *)SERIES_DATA(Prof_Stacks);
+	REBCNT *hash;
+	REBCNT n, i;
+
+	if (Prof_Hash) Free_Series(Prof_Hash);
+	Prof_Hash = Make_Series(size, sizeof(REBCNT), FALSE);
+	KEEP_SERIES(Prof_Hash, "profile hash");
+	Prof_Hash->tail = size;
+	hash = (REBCNT *)SERIES_DATA(Prof_Hash);
+
+	for (n = 0; n < SERIES_TAIL(Prof_Stacks); n++) {
+		for (i = stk[n].hash & (size - 1); hash[i]; i = (i + 1) & (size - 1));
+		hash[i] = n + 1;
+	}
+}
+
+
+/***********************************************************************
+**
+*/	static void Add_Profile_Sample(REBCNT *syms, REBCNT depth, REBI64 time)
+/*
+**		Account time to the stack (symbols are root first).
+**
+***********************************************************************/
+{
+	REBCNT  h = 2166136261u;
+	REBCNT  mask = SERIES_TAIL(Prof_Hash) - 1;
+	REBCNT *hash = (REBCNT *)SERIES_DATA(Prof_Hash);
+	REBPST *stk;
+	REBCNT  n, i;
+
+	for (n = 0; n < depth; n++) h = (h ^ syms[n]) * 16777619u;
+
+	for (i = h & mask; hash[i]; i = (i + 1) & mask) {
+		stk = (REBPST *)SERIES_DATA(Prof_Stacks) + hash[i] - 1;
+		if (
+			stk->hash == h && stk->depth == depth
+			&& !memcmp(SERIES_SKIP(Prof_Syms, stk->offset), syms, depth * sizeof(REBCNT))
+		) goto found;
+	}
+
+	// New stack:
+	n = SERIES_TAIL(Prof_Syms);
+	EXPAND_SERIES_TAIL(Prof_Syms, depth);
+	COPY_MEM(SERIES_SKIP(Prof_Syms, n), syms, depth * sizeof(REBCNT));
+
+	EXPAND_SERIES_TAIL(Prof_Stacks, 1);
+	stk = (REBPST *)SERIES_DATA(Prof_Stacks) + SERIES_TAIL(Prof_Stacks) - 1;
+	CLEARS(stk);
+	stk->offset = n;
+	stk->depth = depth;
+	stk->hash = h;
+	hash[i] = SERIES_TAIL(Prof_Stacks);
+
+	if (SERIES_TAIL(Prof_Stacks) * 2 > mask) {
+		Rehash_Profile((mask + 1) * 2);
+		stk = (REBPST *)SERIES_DATA(Prof_Stacks) + SERIES_TAIL(Prof_Stacks) - 1;
+	}
+
+found:
+	stk->samples++;
+	stk->time += time;
+	Prof_Samples++;
+	Prof_Time += time;
+}
+
+
+/***********************************************************************
+**
+*/	static void Sample_Profile(REBI64 now, REBCNT leaf)
+/*
+**		Record the current call stack. If leaf is not zero, it is
+**		used as an extra symbol at the top of the stack.
+**
+***********************************************************************/
+{
+	REBCNT syms[MAX_PROFILE_DEPTH + 1];
+	REBCNT depth = 0;
+	REBCNT n;
+	REBINT dsf;
+
+	// Count frames to skip the innermost ones of too deep stacks:
+	for (dsf = DSF; dsf > 0; dsf = PRIOR_DSF(dsf)) depth++;
+	n = depth > MAX_PROFILE_DEPTH ? depth - MAX_PROFILE_DEPTH : 0;
+	for (dsf = DSF; dsf > 0 && n > 0; dsf = PRIOR_DSF(dsf)) n--;
+	if (depth > MAX_PROFILE_DEPTH) depth = MAX_PROFILE_DEPTH;
+
+	// Fill the symbols from the root side:
+	for (n = depth; dsf > 0; dsf = PRIOR_DSF(dsf)) {
+		syms[--n] = VAL_WORD_SYM(DSF_WORD(dsf));
+	}
+	if (leaf) syms[depth++] = leaf;
+
+	Add_Profile_Sample(syms, depth, now - Prof_Last);
+	Prof_Last = now;
+}
+
+
+/***********************************************************************
+**
+*/	void Check_Profile(void)
+/*
+**		Take a sample, when the sampling interval elapsed.
+**		Called from the evaluator's signal poll.
+**
+***********************************************************************/
+{
+	REBI64 now = OS_Delta_Time(0, 0);
+	if (now - Prof_Last >= Profile_Interval) Sample_Profile(now, 0);
+}
+
+
+/***********************************************************************
+**
+*/	REBI64 Profile_Enter(void)
+/*
+**		Returns a marker used by Profile_Leave to detect that no
+**		sample was taken while a native was running.
+**
+***********************************************************************/
+{
+	return Prof_Samples + 1;
+}
+
+
+/***********************************************************************
+**
+*/	void Profile_Leave(REBI64 mark)
+/*
+***********************************************************************/
+{
+	if (Profile_Interval && Prof_Samples + 1 == mark) Check_Profile();
+}
+
+
+/***********************************************************************
+**
+*/	void Profile_Recycle(REBI64 start)
+/*
+**		Account time spent in the garbage collector.
+**
+***********************************************************************/
+{
+	REBI64 now = OS_Delta_Time(0, 0);
+
+	Prof_GC_Time += now - start;
+	// time before the GC started belongs to the current stack:
+	if (start > Prof_Last) Sample_Profile(start, 0);
+	Sample_Profile(now, SYM_GC);
+}
+
+
+/***********************************************************************
+**
+*/	void Start_Profile(REBINT interval)
+/*
+**		Start (or resume) sampling. Use zero for default interval.
+**
+***********************************************************************/
+{
+	if (!Prof_Stacks) {
+		Prof_Syms = Make_Series(1024, sizeof(REBCNT), FALSE);
+		KEEP_SERIES(Prof_Syms, "profile symbols");
+		Prof_Stacks = Make_Series(64, sizeof(REBPST), FALSE);
+		KEEP_SERIES(Prof_Stacks, "profile stacks");
+		Rehash_Profile(128);
+	}
+	if (!Profile_Interval) {
+		Prof_Saved_Dose = Eval_Dose;
+		Set_Eval_Dose(PROFILE_DOSE);
+	}
+	Profile_Interval = interval > 0 ? interval : PROFILE_INTERVAL;
+	Prof_Last = OS_Delta_Time(0, 0);
+}
+
+
+/***********************************************************************
+**
+*/	void Stop_Profile(void)
+/*
+***********************************************************************/
+{
+	if (!Profile_Interval) return;
+	Profile_Interval = 0;
+	Set_Eval_Dose(Prof_Saved_Dose);
+}
+
+
+/***********************************************************************
+**
+*/	static void Reset_Profile(void)
+/*
+***********************************************************************/
+{
+	if (Prof_Stacks) {
+		RESET_TAIL(Prof_Syms);
+		RESET_TAIL(Prof_Stacks);
+		Rehash_Profile(128);
+	}
+	Prof_Samples = Prof_Time = Prof_GC_Time = 0;
+	Prof_Last = OS_Delta_Time(0, 0);
+}
+
+
+/***********************************************************************
+**
+*/	static void Set_Time_Usec(REBVAL *val, REBI64 usec)
+/*
+***********************************************************************/
+{
+	VAL_SET(val, REB_TIME);
+	VAL_TIME(val) = usec * 1000;
+}
+
+
+/***********************************************************************
+**
+*/	static REBVAL *Append_Field(REBSER *blk, REBCNT sym)
+/*
+**		Append set-word and return the value slot after it.
+**
+***********************************************************************/
+{
+	REBVAL *val = Append_Value(blk);
+	Init_Word(val, sym);
+	VAL_SET(val, REB_SET_WORD);
+	return Append_Value(blk);
+}
+
+
+/***********************************************************************
+**
+*/	static REBSER *Profile_Block(void)
+/*
+**		Returns: [samples: n time: t gc: t stacks: [[words] n t ...]]
+**
+***********************************************************************/
+{
+	REBCNT count = Prof_Stacks ? SERIES_TAIL(Prof_Stacks) : 0;
+	REBSER *blk = Make_Block(8);
+	REBSER *stacks;
+	REBSER *words;
+	REBVAL *val;
+	REBPST *stk;
+	REBCNT *syms;
+	REBCNT n, i;
+
+	SET_INTEGER(Append_Field(blk, SYM_SAMPLES), Prof_Samples);
+	Set_Time_Usec(Append_Field(blk, SYM_TIME), Prof_Time);
+	Set_Time_Usec(Append_Field(blk, SYM_GC), Prof_GC_Time);
+
+	stacks = Make_Block(count * 3);
+	Set_Block(Append_Field(blk, SYM_STACKS), stacks);
+
+	for (n = 0; n < count; n++) {
+		stk = (REBPST *)SERIES_DATA(Prof_Stacks) + n;
+		syms = (REBCNT *)SERIES_SKIP(Prof_Syms, stk->offset);
+		words = Make_Block(stk->depth);
+		for (i = 0; i < stk->depth; i++) Init_Word(Append_Value(words), syms[i]);
+		val = Append_Value(stacks);
+		Set_Block(val, words);
+		VAL_SET_LINE(val);
+		SET_INTEGER(Append_Value(stacks), stk->samples);
+		Set_Time_Usec(Append_Value(stacks), stk->time);
+	}
+	return blk;
+}
+
+
+/***********************************************************************
+**
+*/	static REBSER *Profile_Folded(void)
+/*
+**		Returns stacks in the "folded" format used by flamegraph
+**		tools: one line per stack, frames separated by semicolons,
+**		followed by the time in microseconds.
+**
+***********************************************************************/
+{
+	REBCNT count = Prof_Stacks ? SERIES_TAIL(Prof_Stacks) : 0;
+	REBSER *out = Make_Binary(count * 32);
+	REBYTE buf[MAX_INT_LEN + 1];
+	REBPST *stk;
+	REBCNT *syms;
+	REBCNT n, i;
+
+	for (n = 0; n < count; n++) {
+		stk = (REBPST *)SERIES_DATA(Prof_Stacks) + n;
+		syms = (REBCNT *)SERIES_SKIP(Prof_Syms, stk->offset);
+		for (i = 0; i < stk->depth; i++) {
+			if (i > 0) Append_Byte(out, ';');
+			Append_UTF8(out, Get_Sym_Name(syms[i]), NO_LIMIT);
+		}
+		Append_Byte(out, ' ');
+		INT_TO_STR(stk->time, buf);
+		Append_Bytes(out, cs_cast(buf));
+		Append_Byte(out, LF);
+	}
+	return out;
+}
+
+
+/***********************************************************************
+**
+*/	REBNATIVE(profiler)
+/*
+//	profiler: native [
+//		"Controls the sampling profiler and returns collected data"
+//		mode [logic! integer! none!] "TRUE or sampling interval (microseconds) to start, FALSE to stop, NONE to get data"
+//		/folded "Return folded stacks (flamegraph input) as a string"
+//		/reset  "Clear collected data"
+//	]
+***********************************************************************/
+{
+	REBVAL *mode = D_ARG(1);
+	REBFLG folded = D_REF(2);
+	REBFLG reset  = D_REF(3);
+
+	Check_Security(SYM_DEBUG, POL_READ, 0);
+
+	if (IS_INTEGER(mode) || IS_TRUE(mode)) {
+		if (reset) Reset_Profile();
+		Start_Profile(IS_INTEGER(mode) ? Int32s(mode, 1) : 0);
+		return R_UNSET;
+	}
+
+	if (IS_LOGIC(mode)) Stop_Profile();
+
+	if (folded) Set_String(D_RET, Profile_Folded());
+	else Set_Block(D_RET, Profile_Block());
+
+	if (reset) Reset_Profile();
+	return R_RET;
+}
+
+
+/***********************************************************************
+**
+**	Call Statistics
+**
+**	Per-function counters updated on each native, action, function
+**	and closure call while Call_Stats_Active is set. Records are
+**	indexed by the symbol of the word used to call the function, so
+**	functions are reported by their names (calls via APPLY and other
+**	anonymous calls are accounted to the none name).
+**
+**	Each instrumented call pushes a frame holding its entry time and
+**	the series allocation counter. Time and allocations of the callees
+**	are subtracted to get the exclusive (self) values. Inclusive values
+**	of recursive functions are counted for the outermost call only.
+**	Frames abandoned by errors (longjmp) are dropped when a frame at the
+**	same or lower stack level is entered or left.
+**
+***********************************************************************/
+
+typedef struct rebol_call_stat {
+	REBI64 calls;
+	REBI64 time;        // inclusive time (microseconds)
+	REBI64 self;        // exclusive time
+	REBI64 allocs;      // inclusive number of series made
+	REBI64 self_allocs; // exclusive number of series made
+	REBCNT active;      // number of frames on the call stack
+} REBCST;
+
+typedef struct rebol_call_frame {
+	REBCNT sym;
+	REBCNT dsf;
+	REBCNT made;        // PG_Reb_Stats->Series_Made at entry
+	REBCNT child_made;  // series made by instrumented callees
+	REBI64 start;
+	REBI64 child;       // time spent in instrumented callees
+} REBCFR;
+
+static REBSER *Call_Table;     // REBCST records indexed by symbol
+static REBSER *Call_Frames;    // REBCFR records of active calls
+
+#define CALL_STAT(n)  ((REBCST *)SERIES_DATA(Call_Table) + (n))
+#define CALL_FRAME(n) ((REBCFR *)SERIES_DATA(Call_Frames) + (n))
+
+
+/***********************************************************************
+**
+*/	static void Drop_Call_Frames(REBCNT depth)
+/*
+**		Remove frames above depth without accounting them.
+**
+***********************************************************************/
+{
+	while (SERIES_TAIL(Call_Frames) > depth) {
+		SERIES_TAIL(Call_Frames)--;
+		CALL_STAT(CALL_FRAME(SERIES_TAIL(Call_Frames))->sym)->active--;
+	}
+}
+
+
+/***********************************************************************
+**
+*/	REBCNT Enter_Call_Stats(void)
+/*
+**		Called before the function of the DSF frame is run.
+**		Returns a token to be passed to Leave_Call_Stats.
+**
+***********************************************************************/
+{
+	REBCNT dsf = DSF;
+	REBCNT sym = VAL_WORD_SYM(DSF_WORD(dsf));
+	REBCNT n = SERIES_TAIL(Call_Frames);
+	REBCFR *frame;
+
+	while (n > 0 && CALL_FRAME(n - 1)->dsf >= dsf) n--;
+	if (n < SERIES_TAIL(Call_Frames)) Drop_Call_Frames(n);
+
+	if (sym >= SERIES_TAIL(Call_Table)) {
+		n = SERIES_TAIL(Call_Table);
+		EXPAND_SERIES_TAIL(Call_Table, sym + 1 - n);
+		CLEAR(CALL_STAT(n), (sym + 1 - n) * sizeof(REBCST));
+	}
+	CALL_STAT(sym)->calls++;
+	CALL_STAT(sym)->active++;
+
+	EXPAND_SERIES_TAIL(Call_Frames, 1);
+	frame = CALL_FRAME(SERIES_TAIL(Call_Frames) - 1);
+	frame->sym = sym;
+	frame->dsf = dsf;
+	frame->made = PG_Reb_Stats->Series_Made;
+	frame->child_made = 0;
+	frame->child = 0;
+	frame->start = OS_Delta_Time(0, 0);
+
+	return SERIES_TAIL(Call_Frames);
+}
+
+
+/***********************************************************************
+**
+*/	void Leave_Call_Stats(REBCNT token)
+/*
+***********************************************************************/
+{
+	REBI64 time = OS_Delta_Time(0, 0);
+	REBCNT made;
+	REBCFR *frame;
+	REBCST *stat;
+
+	if (token > SERIES_TAIL(Call_Frames)) return; // reset while running
+	Drop_Call_Frames(token);
+
+	frame = CALL_FRAME(token - 1);
+	time -= frame->start;
+	made = PG_Reb_Stats->Series_Made - frame->made;
+
+	stat = CALL_STAT(frame->sym);
+	stat->self += time - frame->child;
+	stat->self_allocs += made - frame->child_made;
+	if (--stat->active == 0) {
+		stat->time += time;
+		stat->allocs += made;
+	}
+
+	SERIES_TAIL(Call_Frames)--;
+	if (token > 1) {
+		frame--;
+		frame->child += time;
+		frame->child_made += made;
+	}
+}
+
+
+/***********************************************************************
+**
+*/	static void Reset_Call_Stats(void)
+/*
+***********************************************************************/
+{
+	if (!Call_Table) return;
+	RESET_TAIL(Call_Table);
+	RESET_TAIL(Call_Frames);
+}
+
+
+/***********************************************************************
+**
+*/	static REBSER *Call_Stats_Block(void)
+/*
+**		Returns: [name calls time self allocs self-allocs ...]
+**		with one record per called function.
+**
+***********************************************************************/
+{
+	REBCNT count = Call_Table ? SERIES_TAIL(Call_Table) : 0;
+	REBSER *blk = Make_Block(64);
+	REBVAL *val;
+	REBCST *stat;
+	REBCNT sym;
+
+	for (sym = 0; sym < count; sym++) {
+		stat = CALL_STAT(sym);
+		if (!stat->calls) continue;
+		val = Append_Value(blk);
+		if (sym) Init_Word(val, sym);
+		else SET_NONE(val);
+		VAL_SET_LINE(val);
+		SET_INTEGER(Append_Value(blk), stat->calls);
+		Set_Time_Usec(Append_Value(blk), stat->time);
+		Set_Time_Usec(Append_Value(blk), stat->self);
+		SET_INTEGER(Append_Value(blk), stat->allocs);
+		SET_INTEGER(Append_Value(blk), stat->self_allocs);
+	}
+	return blk;
+}
+
+
+/***********************************************************************
+**
+*/	REBNATIVE(call_stats)
+/*
+//	call-stats: native [
+//		"Controls per-function call counting and returns collected data"
+//		mode [logic! none!] "TRUE to start, FALSE to stop, NONE to get data"
+//		/reset "Clear collected data"
+//	]
+***********************************************************************/
+{
+	REBVAL *mode = D_ARG(1);
+	REBFLG reset = D_REF(2);
+
+	Check_Security(SYM_DEBUG, POL_READ, 0);
+
+	if (IS_TRUE(mode)) {
+		if (!Call_Table) {
+			Call_Table = Make_Series(1024, sizeof(REBCST), FALSE);
+			KEEP_SERIES(Call_Table, "call stats");
+			Call_Frames = Make_Series(64, sizeof(REBCFR), FALSE);
+			KEEP_SERIES(Call_Frames, "call stats frames");
+		}
+		else if (reset) Reset_Call_Stats();
+		Call_Stats_Active = TRUE;
+		return R_UNSET;
+	}
+
+	if (IS_LOGIC(mode)) Call_Stats_Active = FALSE;
+
+	Set_Block(D_RET, Call_Stats_Block());
+	if (reset) Reset_Call_Stats();
+	return R_RET;
+}
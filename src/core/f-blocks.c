@@ -130,7 +130,11 @@
 		if ((ts & TS_SERIES_OBJ) != 0) {
 			// Replace just the series field of the value
 			// Note that this should work for objects too (the frame).
-			VAL_SERIES(val) = Copy_Series(VAL_SERIES(val));
+			// With CP_SHARE, strings are shared until modified.
+			if ((types & CP_SHARE) && ANY_BINSTR(val))
+				VAL_SERIES(val) = Share_Series(VAL_SERIES(val));
+			else
+				VAL_SERIES(val) = Copy_Series(VAL_SERIES(val));
 			if ((types & TYPESET(VAL_TYPE(val)) & TS_BLOCKS_OBJ) != 0) {
 				PG_Reb_Stats->Blocks++;
 				// If we need to copy recursively (deep):
@@ -462,7 +462,10 @@ chkMoney:
 	REBCNT i;
 	REBCNT width = 2;
 	REBVAL *val = D_ARG(1);
-	REBYTE *bin = VAL_BIN_DATA(D_ARG(1));
+	REBYTE *bin;
+
+	TRAP_PROTECT(VAL_SERIES(val));
+	bin = VAL_BIN_DATA(val);
 	if (D_REF(2)) width = VAL_INT32(D_ARG(3));
 
 	REBCNT len = D_REF(4) ? Partial(val, 0, D_ARG(5), 0) : VAL_LEN(val);
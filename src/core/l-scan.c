@@ -42,6 +42,25 @@
 #define LEX_UTFE LEX_WORD
 #endif
 
+// Word-at-a-time (SWAR) tests used to skip plain input 8 bytes per step.
+// Callers must make sure that 8 bytes are readable (see scan_state->limit).
+#define SWAR_ONES  ((REBU64)0x0101010101010101ULL)
+#define SWAR_HIGHS ((REBU64)0x8080808080808080ULL)
+#define SWAR_HAS_LESS(w,n) (((w) - SWAR_ONES * (n)) & ~(w) & SWAR_HIGHS)  // n <= 128
+#define SWAR_HAS_BYTE(w,c) SWAR_HAS_LESS((w) ^ (SWAR_ONES * (c)), 1)
+
+static REBU64 Load_U64(const REBYTE *cp)
+{
+	REBU64 w;
+	memcpy(&w, cp, 8); // unaligned load
+	return w;
+}
+
+// Any control char (so also NUL, CR and LF) in the next 8 bytes?
+#define HAS_CONTROL_8(cp) SWAR_HAS_LESS(Load_U64(cp), 0x0E)
+// Are the next 8 bytes spaces?
+#define IS_SPACE_8(cp) (Load_U64(cp) == SWAR_ONES * ' ')
+
 /***********************************************************************
 **
 */	const REBYTE Lex_Map[256] =
@@ -419,8 +438,20 @@
 	term = (*src++ == '{') ? '}' : '"';	// pick termination
 
 	const REBYTE *start = src;
+	const REBYTE *limit = scan_state ? scan_state->limit : src;
+	REBU64 w;
 
 	while (*src != term || nest > 0) {
+		// Skip runs of plain chars (no escapes, braces, quotes or line ends):
+		while (src + 8 <= limit) {
+			w = Load_U64(src);
+			if (SWAR_HAS_LESS(w, 0x0E) || SWAR_HAS_BYTE(w, '"') || SWAR_HAS_BYTE(w, '^')
+				|| SWAR_HAS_BYTE(w, '{') || SWAR_HAS_BYTE(w, '}')) break;
+			src += 8;
+			len += 8;
+		}
+		if (*src == term && nest == 0) break;
+
 		switch (*src) {
 
 		case CR:
@@ -903,6 +934,7 @@ new_line:
     const REBYTE *cp = scan_state->begin; /* char scan pointer */
     REBCNT flags = 0;               /* lexical flags */
 
+    while (cp + 8 <= scan_state->limit && IS_SPACE_8(cp)) cp += 8; /* indentation */
     while (IS_LEX_SPACE(*cp)) cp++; /* skip white space */
     scan_state->begin = cp;         /* start of lexical symbol */
 
@@ -1006,6 +1038,7 @@ new_line:
         switch (GET_LEX_VALUE(*cp)) {
         case LEX_DELIMIT_SPACE:         /* white space (pre-processed above) */
         case LEX_DELIMIT_SEMICOLON:     /* ; begin comment */
+            while (cp + 8 <= scan_state->limit && !HAS_CONTROL_8(cp)) cp += 8;
             while (NOT_NEWLINE(*cp)) cp++;
             if (!*cp) cp--;             /* avoid passing EOF  */
 			if (*cp == LF) goto line_feed;
@@ -322,12 +322,16 @@ bad_hex:	Trap0(RE_INVALID_CHARS);
 **		Scan and convert an integer value.  Return zero if error.
 **		Allow preceding + - and any combination of ' marks.
 **
+**		Digits are accumulated directly (no copy into a temporary
+**		buffer and no strtoll call), as this is the hot path when
+**		loading large data files.
+**
 ***********************************************************************/
 {
 	REBINT num = (REBINT)len;
-	REBYTE buf[MAX_NUM_LEN+4];
-	REBYTE *bp;
-	REBI64 n = 0;
+	REBU64 n = 0;
+	REBU64 max;
+	REBCNT d;
 	REBOOL neg = FALSE;
 
 	// Super-fast conversion of zero and one (most common cases):
@@ -336,40 +340,26 @@ bad_hex:	Trap0(RE_INVALID_CHARS);
 		if (*cp == '1') {SET_INTEGER(value, 1); return cp+1;}
 	}
 
-	if (len > MAX_NUM_LEN) return 0; // prevent buffer overflow
-	//len = 0;
-	bp = buf;
+	if (len > MAX_NUM_LEN) return 0;
 
 	// Strip leading signs:
-	if (*cp == '-') *bp++ = *cp++, num--, neg = TRUE;
+	if (*cp == '-') cp++, num--, neg = TRUE;
 	else if (*cp == '+') cp++, num--;
 
-	// Remove leading zeros:
-	for (; num > 0; num--) {
-		if (*cp == '0' || *cp == '\'') cp++;
-		else break;
-	}
+	// Magnitude of MIN_I64 is one more than MAX_I64:
+	max = neg ? (REBU64)MAX_I64 + 1 : (REBU64)MAX_I64;
 
-	// Copy all digits, except ' :
-	for (; num > 0; num--) {
-		if (*cp >= '0' && *cp <= '9') *bp++ = *cp++;
-		else if (*cp == '\'') cp++;
-		else return 0;
+	// Convert all digits, except ' :
+	for (; num > 0; num--, cp++) {
+		d = *cp - '0';
+		if (d <= 9) {
+			if (n > (max - d) / 10) return 0; // overflow
+			n = n * 10 + d;
+		}
+		else if (*cp != '\'') return 0;
 	}
-	*bp = 0;
 
-	// Count number of digits
-	len = (REBCNT)(bp - &buf[0]);
-	if (neg) len--;
-	if (len > 0) {
-		if (len > 19) return 0; // Too many digits
-		// Convert, check, and return:
-		errno = 0;
-		n = CHR_TO_INT(buf);
-		if (errno != 0) return 0; //overflow
-		if ((n > 0 && neg) || (n < 0 && !neg)) return 0;
-	}
-	SET_INTEGER(value, n);
+	SET_INTEGER(value, neg ? (REBI64)(0 - n) : (REBI64)n);
 	return cp;
 }
 
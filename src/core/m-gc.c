@@ -286,10 +286,12 @@ static void Mark_Value(REBVAL *val, REBCNT depth);
 /*
 **		Instead of directly marking all series, queue them for later
 **		to avoid a stack overflow in case of deep recursion.
+**		The queue doubles when full, as deep or wide structures of
+**		a big heap can queue millions of series.
 **
 ***********************************************************************/
 {
-	if (SERIES_FULL(GC_Mark_Queue)) Extend_Series(GC_Mark_Queue, 8);
+	if (SERIES_FULL(GC_Mark_Queue)) Extend_Series(GC_Mark_Queue, MAX(8, SERIES_REST(GC_Mark_Queue)));
 	((REBSER**)GC_Mark_Queue->data)[GC_Mark_Queue->tail++] = series;
 }
 
@@ -310,6 +312,9 @@ static void Mark_Value(REBVAL *val, REBCNT depth);
 
 	MARK_SERIES(series);
 
+	// Shared data of a COW string (or the snapshot for them):
+	if (SERIES_GET_FLAG(series, SER_COW | SER_SNAP)) MARK_SERIES(series->series);
+
 	// If not a block, go no further
 	if (SERIES_WIDE(series) != sizeof(REBVAL) || IS_BARE_SERIES(series)) return;
 
@@ -393,6 +398,7 @@ static void Mark_Value(REBVAL *val, REBCNT depth);
 		if (SERIES_WIDE(ser) > sizeof(REBUNI))
 			Crash(RP_BAD_WIDTH, sizeof(REBUNI), SERIES_WIDE(ser), VAL_TYPE(val));
 		MARK_SERIES(ser);
+		if (SERIES_GET_FLAG(ser, SER_COW | SER_SNAP)) MARK_SERIES(ser->series);
 		return;
 	}
 
@@ -535,6 +541,12 @@ static void Mark_Value(REBVAL *val, REBCNT depth);
 **		Scans all series in all segments that are part of the
 **		SERIES_POOL. Free series that have not been marked.
 **
+**		With PARALLEL_SWEEP (and OpenMP) the segments are scanned by
+**		multiple threads. They clear marks of live series and flag the
+**		unmarked ones with SER_SWEEP. Freeing is not thread safe (pool
+**		free lists and stats are shared), so the flagged series are
+**		freed after it by one thread, skipping segments without them.
+**
 ***********************************************************************/
 {
 	REBSEG	*seg;
@@ -542,6 +554,58 @@ static void Mark_Value(REBVAL *val, REBCNT depth);
 	REBCNT  n;
 	REBCNT	count = 0;
 
+#if defined(PARALLEL_SWEEP) && defined(_OPENMP)
+	REBSEG	**segs;
+	REBCNT	*dead;	// number of flagged series per segment
+	REBINT	nsegs = 0;
+	REBINT	i;
+
+	for (seg = Mem_Pools[SERIES_POOL].segs; seg; seg = seg->next) nsegs++;
+
+	// Not counted as REBOL memory (released before the end of the sweep):
+	if (nsegs > 1 && NZ(segs = malloc(nsegs * (sizeof(REBSEG *) + sizeof(REBCNT))))) {
+		dead = (REBCNT *)(segs + nsegs);
+		for (i = 0, seg = Mem_Pools[SERIES_POOL].segs; seg; seg = seg->next) segs[i++] = seg;
+
+		#pragma omp parallel for private(series, n) schedule(dynamic, 16)
+		for (i = 0; i < nsegs; i++) {
+			REBCNT d = 0;
+			series = (REBSER *) (segs[i] + 1);
+			for (n = Mem_Pools[SERIES_POOL].units; n > 0; n--) {
+				SKIP_WALL(series);
+				MUNG_CHECK(SERIES_POOL, series, sizeof(*series));
+				if (!SERIES_FREED(series)) {
+					if (IS_FREEABLE(series)) {
+						SERIES_SET_FLAG(series, SER_SWEEP);
+						d++;
+					} else
+						UNMARK_SERIES(series);
+				}
+				series++;
+				SKIP_WALL(series);
+			}
+			dead[i] = d;
+		}
+
+		for (i = 0; i < nsegs; i++) {
+			series = (REBSER *) (segs[i] + 1);
+			for (n = dead[i]; n > 0;) {
+				SKIP_WALL(series);
+				if (!SERIES_FREED(series) && SERIES_GET_FLAG(series, SER_SWEEP)) {
+					Free_Series(series);
+					n--;
+				}
+				series++;
+				SKIP_WALL(series);
+			}
+			count += dead[i];
+		}
+
+		free(segs);
+		return count;
+	}
+#endif
+
 	for (seg = Mem_Pools[SERIES_POOL].segs; seg; seg = seg->next) {
 		series = (REBSER *) (seg + 1);
 		for (n = Mem_Pools[SERIES_POOL].units; n > 0; n--) {
@@ -640,6 +704,36 @@ static void Mark_Value(REBVAL *val, REBCNT depth);
 }
 
 
+/***********************************************************************
+**
+*/	static REBINT Pace_Recycle(void)
+/*
+**		Compute the ballast for the next automatic recycle.
+**
+**		The ballast set by RECYCLE/ballast is the minimum interval.
+**		Above it, the interval grows with the live memory (GC_Growth
+**		percent of it), so big heaps are not collected too often.
+**		Near the SECURE memory limit it is cut to half of the room
+**		that is left.
+**
+***********************************************************************/
+{
+	REBI64 ballast = VAL_INT32(TASK_BALLAST);
+	REBI64 room;
+
+	if (ballast <= 0) return 0; // recycle/torture
+
+	ballast = MAX(ballast, (REBI64)(PG_Mem_Usage / 100) * GC_Growth);
+
+	if (PG_Mem_Limit != 0) {
+		room = (PG_Mem_Limit > PG_Mem_Usage) ? (REBI64)(PG_Mem_Limit - PG_Mem_Usage) : 0;
+		ballast = MIN(ballast, MAX(room / 2, MEM_BALLAST / 16));
+	}
+
+	return (REBINT)MIN(ballast, MAX_I32);
+}
+
+
 /***********************************************************************
 **
 */	REBI64 Recycle(REBFLG all, REBFLG pools)
@@ -653,6 +747,7 @@ static void Mark_Value(REBVAL *val, REBCNT depth);
 	REBINT n;
 	REBSER **sp;
 	REBCNT count;
+	REBI64 start;
 
 	//Debug_Num("GC", GC_Disabled);
 
@@ -666,6 +761,7 @@ static void Mark_Value(REBVAL *val, REBCNT depth);
 	if (Reb_Opts->watch_recycle) Debug_Str(cs_cast(BOOT_STR(RS_WATCH, 0)));
 #endif
 	GC_Disabled = 1;
+	start = OS_Delta_Time(0, 0);
 
 	PG_Reb_Stats->Recycle_Counter++;
 	PG_Reb_Stats->Recycle_Series = Mem_Pools[SERIES_POOL].free;
@@ -720,18 +816,25 @@ static void Mark_Value(REBVAL *val, REBCNT depth);
 	// Mark all devices:
 	Mark_Devices(0);
 
-	// Mark series queued to avoid a stack overflow in case of deep recursion
+	// Mark series queued to avoid a stack overflow in case of deep recursion.
+	// A series may be queued more than once (or marked since), scan it only once:
 	while (GC_Mark_Queue->tail > 0) {
-		Mark_Series(((REBSER**)GC_Mark_Queue->data)[--GC_Mark_Queue->tail], 0);
+		REBSER *ser = ((REBSER**)GC_Mark_Queue->data)[--GC_Mark_Queue->tail];
+		if (!IS_MARK_SERIES(ser)) Mark_Series(ser, 0);
 	}
-	
+
+	// Ports of periodic timers are not held by the timers:
+	Sweep_Timers();
+
 	count = Sweep_Series();
 	count += Sweep_Gobs();
 	count += Sweep_Handles();
 
 	// Check memory pool segments.
-	// If used recycle/pools refinement, check all segments where usage is less than 90%.
+	// If used recycle/pools refinement, or memory is close to the SECURE limit,
+	// check all segments where usage is less than 90%.
 	// Otherwise, check only pools where usage is less than 20%.
+	if (PG_Mem_Limit != 0 && PG_Mem_Usage > PG_Mem_Limit / 4 * 3) pools = TRUE;
 	Free_Empty_Pool_Segments(pools ? 90 : 20);
 
 	CHECK_MEMORY(4);
@@ -744,8 +847,10 @@ static void Mark_Value(REBVAL *val, REBCNT depth);
 	// Reset stack to prevent invalid MOLD access:
 	RESET_TAIL(DS_Series);
 
-	GC_Ballast = VAL_INT32(TASK_BALLAST);
+	GC_Ballast = GC_Pace = Pace_Recycle();
 	GC_Disabled = 0;
+	PG_Reb_Stats->Recycle_Time += OS_Delta_Time(start, 0);
+	if (Profile_Interval) Profile_Recycle(start);
 #ifdef DEBUG
 	if (Reb_Opts->watch_recycle) Debug_Fmt(BOOT_STR(RS_WATCH, 1), count);
 	//printf("PG_Mem_Usage- %llu\n", PG_Mem_Usage);
@@ -813,6 +918,8 @@ static void Mark_Value(REBVAL *val, REBCNT depth);
 	GC_Active = 0;			// TRUE when recycle is enabled (set by RECYCLE func)
 	GC_Disabled = 0;		// GC disabled counter for critical sections.
 	GC_Ballast = MEM_BALLAST;
+	GC_Pace = MEM_BALLAST;
+	GC_Growth = GC_GROWTH;
 	GC_Last_Infant = 0;		// Keep the last N series safe from GC.
 	GC_Infants = Make_Clear_Mem(sizeof(REBSER*), (MAX_SAFE_SERIES + 2)); // extra
 
@@ -633,8 +633,8 @@ FORCE_INLINE
 	if (IS_EXT_SERIES(series)) goto clear_header;  // Must be library related
 
 	size = SERIES_TOTAL(series);
-	if ((GC_Ballast += size) > VAL_INT32(TASK_BALLAST))
-		GC_Ballast = VAL_INT32(TASK_BALLAST);
+	if ((GC_Ballast += size) > GC_Pace)
+		GC_Ballast = GC_Pace;
 
 	// GC may no longer be necessary:
 	if (GC_Ballast > 0) CLR_SIGNAL(SIG_RECYCLE);
@@ -703,7 +703,8 @@ clear_header:
 	}
 #endif
 	PG_Reb_Stats->Series_Freed++;
-	PG_Reb_Stats->Series_Memory -= SERIES_TOTAL(series);
+	if (!IS_EXT_SERIES(series))
+		PG_Reb_Stats->Series_Memory -= SERIES_TOTAL(series);
 
 	// Remove series from expansion list, if found:
 	for (n = 1; n < MAX_EXPAND_LIST; n++) {
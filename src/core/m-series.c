@@ -71,6 +71,8 @@
 
 	if (delta == 0) return;
 
+	UNSHARE_SERIES(series);
+
 	// Optimized case of head insertion:
 	if (index == 0 && SERIES_BIAS(series) >= delta) {
 		series->data -= SERIES_WIDE(series) * delta;
@@ -268,6 +270,82 @@
 }
 
 
+/***********************************************************************
+**
+*/	REBSER *Share_Series(REBSER *source)
+/*
+**		Copy a string or binary series, sharing its data copy-on-write.
+**
+**		The new series points to the data of a snapshot copy of the
+**		source (kept in source->series and reused while the source
+**		content is unchanged), so many copies of one string cost one
+**		copy of the data. The shared data is never modified: it is
+**		copied by Unshare_Series before the first modification.
+**		Its rest is tail + 1, so any expansion must reallocate.
+**
+***********************************************************************/
+{
+	REBSER *snap;
+	REBSER *series;
+	REBCNT wide = SERIES_WIDE(source);
+
+	if (IS_COW_SERIES(source)) snap = source->series;
+	else {
+		snap = SERIES_GET_FLAG(source, SER_SNAP) ? source->series : 0;
+		if (!snap
+			|| SERIES_TAIL(snap) != SERIES_TAIL(source)
+			|| SERIES_WIDE(snap) != wide
+			|| IS_UTF8_SERIES(snap) != IS_UTF8_SERIES(source)
+			|| memcmp(snap->data, source->data, SERIES_TAIL(source) * wide)
+		) {
+			snap = Copy_Series(source);
+			source->series = snap;
+			SERIES_SET_FLAG(source, SER_SNAP);
+		}
+	}
+
+	series = (REBSER *)Make_Node(SERIES_POOL);
+	series->data = snap->data;
+	series->tail = snap->tail;
+	series->rest = snap->tail + 1;
+	series->sizes = wide; // also clears bias
+	SERIES_FLAGS(series) = SER_EXT | SER_COW | (SERIES_FLAGS(snap) & SER_UTF8);
+	series->series = snap;
+	LABEL_SERIES(series, "cow");
+
+	PG_Reb_Stats->Series_Made++;
+
+	return series;
+}
+
+
+/***********************************************************************
+**
+*/	void Unshare_Series(REBSER *series)
+/*
+**		Give a copy-on-write series its own copy of the data.
+**		Must be done before any modification of the series.
+**
+***********************************************************************/
+{
+	REBSER *newser;
+	REBSER swap;
+	REBCNT flags = SERIES_FLAGS(series) & ~(SER_EXT | SER_COW);
+
+	newser = Copy_Series(series);
+
+	// Same swap as Expand_Series; the old header keeps SER_EXT,
+	// so freeing it leaves the shared data alone:
+	swap = *series;
+	*series = *newser;
+	*newser = swap;
+	Free_Series(newser);
+
+	SERIES_FLAGS(series) = flags;
+	series->series = 0;
+}
+
+
 /***********************************************************************
 **
 */	REBSER *Copy_Series_Part(REBSER *source, REBCNT index, REBCNT length)
@@ -344,6 +422,8 @@
 
 	if (len <= 0) return;
 
+	UNSHARE_SERIES(series);
+
 	// Optimized case of head removal:
 	if (index == 0) {
 		if ((REBCNT)len > series->tail) len = series->tail;
@@ -414,6 +494,7 @@
 ***********************************************************************/
 {
 	if (series->tail == 0) return;
+	UNSHARE_SERIES(series);
 	series->tail--;
 	CLEAR(series->data + SERIES_WIDE(series) * series->tail, SERIES_WIDE(series));
 }
@@ -448,6 +529,7 @@
 **
 ***********************************************************************/
 {
+	UNSHARE_SERIES(series);
 	series->tail = 0;
 	if (SERIES_BIAS(series)) Reset_Bias(series);
 	CLEAR(series->data, SERIES_WIDE(series)); // re-terminate
@@ -463,6 +545,7 @@
 **
 ***********************************************************************/
 {
+	UNSHARE_SERIES(series);
 	series->tail = 0;
 	if (SERIES_BIAS(series)) Reset_Bias(series);
 	CLEAR(series->data, SERIES_SPACE(series));
@@ -478,6 +561,7 @@
 **
 ***********************************************************************/
 {
+	UNSHARE_SERIES(series);
 	series->tail = 0;
 	if (SERIES_BIAS(series)) Reset_Bias(series);
 	EXPAND_SERIES_TAIL(series, size);
@@ -494,6 +578,7 @@
 **
 ***********************************************************************/
 {
+	UNSHARE_SERIES(series);
 	CLEAR(series->data + SERIES_WIDE(series) * series->tail, SERIES_WIDE(series));
 }
 
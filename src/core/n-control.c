@@ -349,7 +349,7 @@
 /*
 ***********************************************************************/
 {
-	Try_Block(VAL_SERIES(D_ARG(1)), VAL_INDEX(D_ARG(1)));
+	Try_Block(VAL_SERIES(D_ARG(1)), VAL_INDEX(D_ARG(1)), TRUE);
 	if (IS_ERROR(DS_NEXT) && (D_REF(2) || !IS_THROW(DS_NEXT))) return R_NONE;
 	return R_TOS1;
 }
@@ -910,7 +910,7 @@ callback:	// ...and the last result.
 		handler = *D_ARG(ARG_TRY_HANDLER);
 	}
 	// TRY exception will trim the stack
-	if (Try_Block(VAL_SERIES(D_ARG(ARG_TRY_BLOCK)), VAL_INDEX(D_ARG(ARG_TRY_BLOCK)))) {
+	if (Try_Block(VAL_SERIES(D_ARG(ARG_TRY_BLOCK)), VAL_INDEX(D_ARG(ARG_TRY_BLOCK)), FALSE)) {
 		// save the error as a system/state/last-error value
 	on_error:
 		*error = *DS_NEXT;
@@ -1061,6 +1061,7 @@ static int Do_Ordinal(REBVAL *ds, REBINT n)
 	REBINT index = VAL_INDEX(arg);
 	REBINT len = -1;
 	
+	TRAP_PROTECT(VAL_SERIES(arg));
 	if (D_REF(2)) {
 		len = Partial(arg, 0, D_ARG(3), 0);
 	}
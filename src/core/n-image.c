@@ -466,6 +466,8 @@ double weighted_rgb_color_distance(long r1, long g1, long b1, long r2, long g2,
 //		 name     [word! integer!] "One of: system/catalog/filters"
 //		/blur
 //		 factor  [number!]   "The blur factor where > 1 is blurry, < 1 is sharp"
+//		/into                      "Store the result in an existing image"
+//		 target   [image!]         "Image of the requested size (modified)"
 //	]
 ***********************************************************************/
 {
@@ -475,6 +477,9 @@ double weighted_rgb_color_distance(long r1, long g1, long b1, long r2, long g2,
 	REBVAL *val_filter = D_ARG(4);
 	REBOOL  ref_blur   = D_REF(5);
 	REBVAL *val_blur   = D_ARG(6);
+	REBOOL  ref_into   = D_REF(7);
+	REBVAL *val_target = D_ARG(8);
+	REBSER *target     = NULL;
 	REBSER *result;
 	REBCNT  filter = 0;
 	REBDEC  blur = 1.0;
@@ -517,12 +522,22 @@ double weighted_rgb_color_distance(long r1, long g1, long b1, long r2, long g2,
 		high = ROUND_TO_INT( VAL_IMAGE_HIGH(val_img) * wide / VAL_IMAGE_WIDE(val_img) );
 	}
 		
-	result = ResizeImage(VAL_SERIES(val_img), wide, high, filter, blur, has_alpha);
+	if (ref_into) {
+		target = VAL_SERIES(val_target);
+		if (wide != (REBINT)IMG_WIDE(target) || high != (REBINT)IMG_HIGH(target))
+			Trap1(RE_INVALID_ARG, val_target);
+	}
+
+	result = ResizeImage(VAL_SERIES(val_img), wide, high, filter, blur, has_alpha, target);
 
 	if (result == NULL) {
 		Trap1(RE_NO_CREATE, Get_Type_Word(REB_IMAGE));
 	}
 
+	if (ref_into) {
+		*D_RET = *val_target;
+		return R_RET;
+	}
 	SET_IMAGE(D_RET, result);
 	return R_RET;
 }
@@ -611,6 +626,7 @@ double weighted_rgb_color_distance(long r1, long g1, long b1, long r2, long g2,
 
 #ifdef INCLUDE_IMAGE_OS_CODEC
 	CLEARS(&codi);
+	codi.level = -1;
 	if (ref_as) {
 		switch (VAL_WORD_CANON(val_type)) {
 			case SYM_PNG:   codi.type = CODI_IMG_PNG;  break;
@@ -39,12 +39,211 @@ enum loop_each_mode {
 	LM_MAP
 };
 
+/*
+**	Loop body cache:
+**
+**	Init_Loop copies the loop body and binds the copy to a new frame.
+**	When no loop word can escape the body (see Closed_Loop_Body), the
+**	bound copy and its frame are kept in the TASK_LOOP_CACHE block and
+**	reused the next time the same body is entered with the same loop
+**	words, so a short loop inside a function called many times does
+**	not deep copy and rebind its body on every call.
+**
+**	An entry is reused only if the copy still matches its source
+**	(see Same_Loop_Body), so modifying the source block, or literal
+**	series in the copy while the loop runs, gives a fresh copy.
+**	LC_OWNER holds the DSF of the loop using the entry (End_Loop clears
+**	it). A loop that is not an ancestor of the caller (its DSF is not
+**	below the current DSF) has finished, so its entry is free; that
+**	also frees entries of loops left by an error.
+*/
+#define LOOP_CACHE_SIZE 64	// must be power of 2
+
+#define LOOP_CACHE_SLOT(ser, idx) \
+	((((REBUPT)(ser) >> 4) ^ (idx)) & (LOOP_CACHE_SIZE - 1))
+
+enum loop_cache_values {
+	LC_SOURCE = 0,	// body block given to the loop
+	LC_BODY,		// its bound copy
+	LC_FRAME,		// frame of the loop words
+	LC_OWNER,		// DSF of the loop using it (or none)
+	LC_MAX
+};
+
+#define LOOP_CACHE_ENTRY(slot) BLK_SKIP(VAL_SERIES(TASK_LOOP_CACHE), (slot) * LC_MAX)
+
+
+/***********************************************************************
+**
+*/	static REBFLG Quotes_Args(REBVAL *word)
+/*
+**		Returns TRUE if the word refers to a function that takes
+**		any argument unevaluated (it could get a loop word).
+**
+***********************************************************************/
+{
+	REBVAL *val = Get_Var_No_Trap(word);
+	REBVAL *args;
+
+	if (!val || !ANY_FUNC(val)) return FALSE;
+	for (args = BLK_SKIP(VAL_FUNC_WORDS(val), 1); NOT_END(args); args++) {
+		if (IS_LIT_WORD(args) || IS_GET_WORD(args)) return TRUE;
+	}
+	return FALSE;
+}
+
+
+/***********************************************************************
+**
+*/	static REBFLG Closed_Loop_Body(REBVAL *val, REBSER *frame, REBFLG top)
+/*
+**		Returns TRUE when no word bound to the loop frame can escape
+**		the body, so the body and frame may be used by the next run.
+**
+**		Loop words may only be evaluated: used as words, set-words or
+**		get-words in the body itself, in its parens and paths (top).
+**		In a nested block (which may be kept, e.g. by DOES or
+**		APPEND/ONLY) or as a lit-word they could escape. A function
+**		taking an unevaluated argument could also get the word.
+**
+***********************************************************************/
+{
+	for (; NOT_END(val); val++) {
+		if (ANY_WORD(val)) {
+			if (VAL_WORD_FRAME(val) == frame) {
+				if (!top || !(IS_WORD(val) || IS_SET_WORD(val) || IS_GET_WORD(val)))
+					return FALSE;
+			}
+			else if (top && IS_WORD(val) && Quotes_Args(val))
+				return FALSE;
+		}
+		else if (ANY_BLOCK(val)) {
+			if (!Closed_Loop_Body(
+				BLK_HEAD(VAL_SERIES(val)), frame,
+				top && !IS_BLOCK(val) && !IS_LIT_PATH(val)
+			)) return FALSE;
+		}
+	}
+	return TRUE;
+}
+
+
+/***********************************************************************
+**
+*/	static REBFLG Same_Loop_Body(REBVAL *src, REBVAL *copy, REBCNT len, REBSER *frame)
+/*
+**		Compare a source block with its bound copy made by Init_Loop.
+**		Words bound to the loop frame must have the same symbol,
+**		copied series must have the same content, all other values
+**		must be the same bits.
+**
+***********************************************************************/
+{
+	REBSER *ss;
+	REBSER *cs;
+
+	for (; len > 0; len--, src++, copy++) {
+		if (src->flags.header != copy->flags.header) return FALSE;
+		if (ANY_WORD(copy) && VAL_WORD_FRAME(copy) == frame) {
+			if (VAL_WORD_SYM(src) != VAL_WORD_SYM(copy)) return FALSE;
+		}
+		else if (ANY_SERIES(copy) && VAL_SERIES(src) != VAL_SERIES(copy)) {
+			ss = VAL_SERIES(src);
+			cs = VAL_SERIES(copy);
+			if (
+				VAL_INDEX(src) != VAL_INDEX(copy)
+				|| SERIES_TAIL(ss) != SERIES_TAIL(cs)
+				|| SERIES_WIDE(ss) != SERIES_WIDE(cs)
+			) return FALSE;
+			if (ANY_BLOCK(copy)) {
+				if (!Same_Loop_Body(BLK_HEAD(ss), BLK_HEAD(cs), SERIES_TAIL(ss), frame))
+					return FALSE;
+			}
+			else if (memcmp(ss->data, cs->data, SERIES_TAIL(ss) * SERIES_WIDE(ss)))
+				return FALSE;
+		}
+		else if (memcmp(&src->data, &copy->data, sizeof(src->data)))
+			return FALSE;
+	}
+	return TRUE;
+}
+
+
 /***********************************************************************
 **
-*/	static REBSER *Init_Loop(REBVAL *spec, REBVAL *body_blk, REBSER **fram)
+*/	static REBSER *Find_Loop_Body(REBVAL *spec, REBVAL *body_blk, REBSER **fram, REBCNT slot)
+/*
+**		Return a cached bound copy of the body (and its frame) if
+**		there is one for the same body and loop words, or zero.
+**
+***********************************************************************/
+{
+	REBVAL *entry = LOOP_CACHE_ENTRY(slot);
+	REBSER *frame;
+	REBSER *body;
+	REBVAL *word;
+	REBVAL *vals;
+	REBINT len;
+
+	if (!IS_BLOCK(entry + LC_SOURCE)
+		|| VAL_SERIES(entry + LC_SOURCE) != VAL_SERIES(body_blk)
+		|| VAL_INDEX(entry + LC_SOURCE) != VAL_INDEX(body_blk)
+		|| (IS_INTEGER(entry + LC_OWNER) && VAL_INT32(entry + LC_OWNER) < DSF)
+	) return 0;
+
+	body = VAL_SERIES(entry + LC_BODY);
+	frame = VAL_OBJ_FRAME(entry + LC_FRAME);
+
+	// The loop words must be the same:
+	len = IS_BLOCK(spec) ? VAL_LEN(spec) : 1;
+	if (len + 1 != (REBINT)SERIES_TAIL(frame)) return 0;
+	word = FRM_WORD(frame, 1);
+	if (IS_BLOCK(spec)) spec = VAL_BLK_DATA(spec);
+	for (; len > 0; len--, word++, spec++) {
+		if (VAL_TYPE(word) != VAL_TYPE(spec) || VAL_BIND_SYM(word) != VAL_WORD_SYM(spec))
+			return 0;
+	}
+
+	if (VAL_LEN(body_blk) != SERIES_TAIL(body)
+		|| !Same_Loop_Body(VAL_BLK_DATA(body_blk), BLK_HEAD(body), SERIES_TAIL(body), frame)
+		|| !Closed_Loop_Body(BLK_HEAD(body), frame, TRUE) // functions may be redefined
+	) return 0;
+
+	for (vals = FRM_VALUE(frame, 1); NOT_END(vals); vals++) SET_NONE(vals);
+
+	SET_INTEGER(entry + LC_OWNER, DSF);
+	*fram = frame;
+	return body;
+}
+
+
+/***********************************************************************
+**
+*/	static void End_Loop(REBSER *frame, REBINT slot)
+/*
+**		Called when a loop ends (also by BREAK). Releases the cache
+**		entry used by the loop and the values of its loop words (the
+**		frame is kept, so they must not stay alive until the next run).
+**
+***********************************************************************/
+{
+	REBVAL *vals;
+
+	if (slot < 0) return;
+	for (vals = FRM_VALUE(frame, 1); NOT_END(vals); vals++) SET_NONE(vals);
+	SET_NONE(LOOP_CACHE_ENTRY(slot) + LC_OWNER);
+}
+
+
+/***********************************************************************
+**
+*/	static REBSER *Init_Loop(REBVAL *spec, REBVAL *body_blk, REBSER **fram, REBINT *cache_slot)
 /*
 **		Initialize standard for loops (copy block, make frame, bind).
 **		Spec: WORD or [WORD ...]
+**		A bound copy left by a prior run of the same loop is reused
+**		when possible (see the loop body cache notes above). The used
+**		cache slot (or -1) is returned for End_Loop.
 **
 ***********************************************************************/
 {
@@ -53,10 +252,29 @@ enum loop_each_mode {
 	REBVAL *word;
 	REBVAL *vals;
 	REBSER *body;
+	REBVAL *entry;
+	REBCNT slot;
+
+	*cache_slot = -1;
 
 	// For :WORD format, get the var's value:
 	if (IS_GET_WORD(spec)) spec = Get_Var(spec);
 
+	if (!IS_BLOCK(TASK_LOOP_CACHE)) {
+		body = Make_Block(LOOP_CACHE_SIZE * LC_MAX);
+		for (len = 0; len < LOOP_CACHE_SIZE * LC_MAX; len++) SET_NONE(Append_Value(body));
+		Set_Root_Series(TASK_LOOP_CACHE, body, cb_cast("loop bodies"));
+	}
+
+	slot = LOOP_CACHE_SLOT(VAL_SERIES(body_blk), VAL_INDEX(body_blk));
+	if (IS_BLOCK(spec) || IS_WORD(spec)) {
+		body = Find_Loop_Body(spec, body_blk, fram, slot);
+		if (body) {
+			*cache_slot = slot;
+			return body;
+		}
+	}
+
 	// Hand-make a FRAME (done for for speed):
 	len = IS_BLOCK(spec) ? VAL_LEN(spec) : 1;
 	if (len == 0) Trap_Arg(spec);
@@ -98,6 +316,19 @@ enum loop_each_mode {
 
 	*fram = frame;
 
+	// Keep it for the next run, unless the slot is used by an outer loop:
+	entry = LOOP_CACHE_ENTRY(slot);
+	if (
+		!(IS_INTEGER(entry + LC_OWNER) && VAL_INT32(entry + LC_OWNER) < DSF)
+		&& Closed_Loop_Body(BLK_HEAD(body), frame, TRUE)
+	) {
+		entry[LC_SOURCE] = *body_blk;
+		Set_Block(entry + LC_BODY, body);
+		SET_OBJECT(entry + LC_FRAME, frame);
+		SET_INTEGER(entry + LC_OWNER, DSF);
+		*cache_slot = slot;
+	}
+
 	return body;
 }
 
@@ -358,13 +589,14 @@ cont_utf8:
 	REBCNT j;
 	REBOOL return_count = FALSE;
 	REBLEN removed_uni = 0;
+	REBINT slot;
 
 	ASSERT2(mode >= 0 && mode < 4, RP_MISC);
 
 	value = D_ARG(2); // series
 	if (IS_NONE(value)) return R_NONE;
 
-	body = Init_Loop(D_ARG(1), D_ARG(3), &frame); // vars, body
+	body = Init_Loop(D_ARG(1), D_ARG(3), &frame, &slot); // vars, body
 	SET_OBJECT(D_ARG(1), frame); // keep GC safe
 	Set_Block(D_ARG(3), body);	 // keep GC safe
 
@@ -397,6 +629,7 @@ cont_utf8:
 		series = VAL_SERIES(value);
 		index  = VAL_INDEX(value);
 		if (index >= SERIES_TAIL(series)) {
+			End_Loop(frame, slot);
 			if (mode == LM_REMOVE) {
 				if(return_count)
 					SET_INTEGER(D_RET, 0);
@@ -406,8 +639,7 @@ cont_utf8:
 		}
 	}
 
-	if (mode==LM_REMOVE && IS_PROTECT_SERIES(series)) 
-		Trap0(RE_PROTECTED);
+	if (mode==LM_REMOVE) TRAP_PROTECT(series);
 	
 	windex = index;
 
@@ -554,6 +786,8 @@ cont_utf8:
 skip_hidden: ;
 	}
 
+	End_Loop(frame, slot);
+
 	// Finish up:
 	if (mode == LM_REMOVE) {
 		// Remove hole (updates tail):
@@ -593,9 +827,10 @@ skip_hidden: ;
 	REBVAL *start = D_ARG(2);
 	REBVAL *end   = D_ARG(3);
 	REBVAL *incr  = D_ARG(4);
+	REBINT slot;
 
 	// Copy body block, make a frame, bind loop var to it:
-	body = Init_Loop(D_ARG(1), D_ARG(5), &frame);
+	body = Init_Loop(D_ARG(1), D_ARG(5), &frame, &slot);
 	var = FRM_VALUE(frame, 1); // safe: not on stack
 	SET_OBJECT(D_ARG(1), frame); // keep GC safe
 	Set_Block(D_ARG(5), body);	 // keep GC safe
@@ -622,6 +857,7 @@ skip_hidden: ;
 	else
 		Loop_Number(var, body, start, end, incr);
 
+	End_Loop(frame, slot);
 	return R_TOS1;
 }
 
@@ -743,6 +979,7 @@ skip_hidden: ;
 	REBSER *frame;
 	REBVAL *var;
 	REBVAL *count = D_ARG(2);
+	REBINT slot;
 
 	if (IS_NONE(count)) return R_NONE;
 
@@ -751,7 +988,7 @@ skip_hidden: ;
 		VAL_SET(count, REB_INTEGER);
 	}
 
-	body = Init_Loop(D_ARG(1), D_ARG(3), &frame);
+	body = Init_Loop(D_ARG(1), D_ARG(3), &frame, &slot);
 	var = FRM_VALUE(frame, 1); // safe: not on stack
 	SET_OBJECT(D_ARG(1), frame); // keep GC safe
 	Set_Block(D_ARG(3), body);	 // keep GC safe
@@ -771,6 +1008,7 @@ skip_hidden: ;
 		Loop_Pair(var, body, 1., 1., VAL_PAIR_X(count), VAL_PAIR_Y(count), 1., 1.);
 	}
 
+	End_Loop(frame, slot);
 	return R_TOS1;
 }
 
@@ -516,7 +516,7 @@ static struct digest {
 	REBVAL *data = D_ARG(1);
 	REBVAL *key  = D_ARG(2);
 
-	if (IS_PROTECT_SERIES(VAL_SERIES(data))) Trap0(RE_PROTECTED);
+	TRAP_PROTECT(VAL_SERIES(data));
 
 	if (!Cloak(TRUE, VAL_BIN_DATA(data), VAL_LEN(data), (REBYTE*)key, 0, D_REF(3)))
 		Trap_Arg(key);
@@ -536,7 +536,7 @@ static struct digest {
 	REBVAL *data = D_ARG(1);
 	REBVAL *key  = D_ARG(2);
 	
-	if (IS_PROTECT_SERIES(VAL_SERIES(data))) Trap0(RE_PROTECTED);
+	TRAP_PROTECT(VAL_SERIES(data));
 
 	if (!Cloak(FALSE, VAL_BIN_DATA(data), VAL_LEN(data), (REBYTE*)key, 0, D_REF(3)))
 		Trap_Arg(key);
@@ -716,7 +716,7 @@ static struct digest {
 	REBVAL *val = D_ARG(1);
 	REBINT len = VAL_LEN(val);
 
-	if (IS_PROTECT_SERIES(VAL_SERIES(val))) Trap0(RE_PROTECTED);
+	TRAP_PROTECT(VAL_SERIES(val));
 
 	if (D_REF(2)) { //lines
 		Set_Block(D_RET, Split_Lines(val));
@@ -740,7 +740,7 @@ static struct digest {
 	REBVAL *val = D_ARG(1);
 	REBSER *ser = VAL_SERIES(val);
 
-	if (IS_PROTECT_SERIES(VAL_SERIES(val))) Trap0(RE_PROTECTED);
+	TRAP_PROTECT(VAL_SERIES(val));
 	if (IS_BLOCK(val)) Trap0(RE_NOT_DONE);
 
 	if (SERIES_TAIL(ser)) {
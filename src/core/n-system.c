@@ -92,6 +92,13 @@
 		SET_INT32(TASK_BALLAST, VAL_INT32(TASK_MAX_BALLAST));
 	}
 
+	if (D_REF(7)) { // /tune
+		REBVAL *growth = D_ARG(8);
+		REBI64 n = IS_PERCENT(growth) ? (REBI64)(VAL_DECIMAL(growth) * 100) : VAL_INT64(growth);
+		if (n < 0 || n > MAX_I32 / 100) Trap_Arg(growth);
+		GC_Growth = (REBINT)n;
+	}
+
 	if (D_REF(5)) { // torture
 		GC_Active = TRUE;
 		SET_INT32(TASK_BALLAST, 0);
@@ -184,6 +191,12 @@
 
 			stats++;
 			SET_INTEGER(stats, PG_Reb_Stats->Recycle_Counter);
+			stats++;
+			VAL_TIME(stats) = PG_Reb_Stats->Recycle_Time * 1000;
+			VAL_SET(stats, REB_TIME);
+			stats++;
+			n = OS_Delta_Time(PG_Boot_Time, 0);
+			SET_PERCENT(stats, n > 0 ? (REBDEC)PG_Reb_Stats->Recycle_Time / n : 0.0);
 #ifdef DEBUG_HASH_COLLISIONS
 			stats++;
 			SET_INTEGER(stats, Eval_Collisions);
@@ -443,8 +456,9 @@ err:
 **	Args:
 **		1: codec:  handle!
 **		2: action: word! (identify, decode, encode)
-**		3: data:   binary! image! sound!
-**		4: option: (optional)
+**		3: data:   binary! image! sound! (or any value to encode)
+**		4: /as
+**		5: level:  integer! (codec specific)
 **
 ***********************************************************************/
 {
@@ -458,6 +472,7 @@ err:
 
 	CLEAR(&codi, sizeof(codi));
 	codi.action = CODI_DECODE;
+	codi.level = D_REF(4) ? VAL_INT32(D_ARG(5)) : -1;
 
 	val = D_ARG(3);
 
@@ -469,6 +484,7 @@ err:
 		if (!IS_BINARY(val)) Trap1(RE_INVALID_ARG, val);
 		codi.data = VAL_BIN_DATA(D_ARG(3));
 		codi.len  = VAL_LEN(D_ARG(3));
+		codi.other = D_RET;
 		break;
 
 	case SYM_ENCODE:
@@ -479,8 +495,11 @@ err:
 			codi.h = VAL_IMAGE_HIGH(val);
 			codi.alpha = Image_Has_Alpha(val, 0);
 		}
-		else
-			Trap1(RE_INVALID_ARG, val);
+		else {
+			// image codecs do not know this action and refuse it
+			codi.action = CODI_ENCODE_VALUE;
+			codi.other = val;
+		}
 		break;
 
 	default:
@@ -529,6 +548,9 @@ err:
 	case CODI_STRING:
 		Set_String(D_RET, codi.other);
 		break;
+	case CODI_VALUE:
+		*D_RET = *(REBVAL *)codi.other;
+		break;
 
 	default:
 		Trap0(RE_BAD_MEDIA); // need better!!!
@@ -36,23 +36,81 @@
 #define WILD_PATH(p) (Find_Str_Wild(VAL_SERIES(p), VAL_INDEX(p), VAL_TAIL(p)) != NOT_FOUND)
 
 
+// Read_Dir options:
+#define DIR_INFO 1	// append size and modification date after each name
+#define DIR_DEEP 2	// walk into subdirectories too
+
+#ifdef TO_WINDOWS
+#define SAME_NAME_CHAR(a,b) ((a) == (b) || ((a) < 0x80 && (b) < 0x80 && LO_CASE(a) == LO_CASE(b)))
+#else
+#define SAME_NAME_CHAR(a,b) ((a) == (b))
+#endif
+
+#define UTF8_TRAIL(c) (((c) & 0xC0) == 0x80)
+
+
+/***********************************************************************
+**
+*/	static REBOOL Match_Wild_Name(const REBYTE *name, REBCNT nlen, const REBYTE *pat, REBCNT plen)
+/*
+**		Match a whole UTF-8 file name against a pattern with * and ?
+**		wildcards. Backtracks only to the last *, so the usual
+**		patterns like *.txt are matched in linear time.
+**
+***********************************************************************/
+{
+	REBCNT n = 0, p = 0;
+	REBCNT star = NOT_FOUND, mark = 0;
+
+	while (n < nlen) {
+		if (p < plen && pat[p] == '*') {
+			star = p++;
+			mark = n;
+		}
+		else if (p < plen && pat[p] == '?') {
+			// one char, not just one byte of its UTF-8 sequence
+			p++;
+			do n++; while (n < nlen && UTF8_TRAIL(name[n]));
+		}
+		else if (p < plen && SAME_NAME_CHAR(pat[p], name[n])) {
+			p++;
+			n++;
+		}
+		else if (star != NOT_FOUND) {
+			p = star + 1;
+			do mark++; while (mark < nlen && UTF8_TRAIL(name[mark]));
+			n = mark;
+		}
+		else return FALSE;
+	}
+	while (p < plen && pat[p] == '*') p++;
+	return p == plen;
+}
+
+
 /***********************************************************************
 **
-*/	static int Read_Dir(REBREQ *dir, REBSER *files)
+*/	static int Read_Dir(REBREQ *dir, REBSER *files, REBSER *prefix, REBVAL *pattern, REBSER *subdirs, REBCNT opts)
 /*
 **		Provide option to get file info too.
 **		Provide option to prepend dir path.
 **		Provide option to use wildcards.
 **
+**		Names are appended to files, each with the optional prefix
+**		(relative path of the directory being read). When a pattern
+**		is given, only matching names are appended. Found directories
+**		are collected in subdirs, if provided, for a deep walk.
+**
 ***********************************************************************/
 {
 	REBINT result;
 	REBCNT len;
+	REBCNT skip = prefix ? SERIES_TAIL(prefix) : 0;
 	REBSER *fname;
 	REBSER *name;
 	REBREQ file;
+	REBOOL is_dir;
 
-	RESET_TAIL(files);
 	CLEARS(&file);
 
 	// Temporary filename storage:
@@ -60,6 +118,7 @@
 	file.file.path = (REBCHR*)Reset_Buffer(fname, MAX_FILE_NAME);
 
 	SET_FLAG(dir->modes, RFM_DIR);
+	if (opts & DIR_INFO) SET_FLAG(dir->modes, RFM_INFO);
 
 	dir->data = (REBYTE*)(&file);
 
@@ -72,13 +131,22 @@
 #endif
 
 	while ((result = OS_Do_Device(dir, RDC_READ)) == 0 && !GET_FLAG(dir->flags, RRF_DONE)) {
+		is_dir = GET_FLAG(file.modes, RFM_DIR);
 		len = (REBCNT)LEN_STR(file.file.path);
-		if (GET_FLAG(file.modes, RFM_DIR)) len++;
+		if (is_dir) len++;
 		name = Copy_OS_Str(file.file.path, len);
-		if (GET_FLAG(file.modes, RFM_DIR)) {
+		if (is_dir) {
 			SET_ANY_CHAR(name, name->tail-1, '/');
 		}
+		if (prefix) Insert_String(name, 0, prefix, 0, skip, 0);
+		if (subdirs && is_dir) Set_Series(REB_FILE, Append_Value(subdirs), name);
+		if (pattern && !Match_Wild_Name(BIN_SKIP(name, skip), name->tail - skip - (is_dir ? 1 : 0), VAL_BIN_DATA(pattern), VAL_LEN(pattern)))
+			continue;
 		Set_Series(REB_FILE, Append_Value(files), name);
+		if (opts & DIR_INFO) {
+			Set_File_Mode_Value(&file, SYM_SIZE, Append_Value(files));
+			Set_File_Mode_Value(&file, SYM_MODIFIED, Append_Value(files));
+		}
 	}
 
 	return result;
@@ -153,6 +221,65 @@
 }
 
 
+/***********************************************************************
+**
+*/	static int Read_Dir_Tree(REBREQ *dir, REBVAL *path, REBSER *files, REBCNT opts)
+/*
+**		Read a directory with options (see DIR_*). A wildcard in the
+**		last path segment is matched here, so it applies at every level
+**		of a deep walk. The walk is breadth first over the queue of found
+**		subdirectories (no C recursion); names are relative to the top
+**		directory. Unreadable subdirectories are skipped.
+**
+***********************************************************************/
+{
+	REBSER *subdirs = (opts & DIR_DEEP) ? Make_Block(7) : 0;
+	REBVAL *pattern = 0;
+	REBVAL *rel;
+	REBVAL base;
+	REBVAL wild;
+	REBVAL sub_path;
+	REBREQ sub;
+	REBSER *full;
+	REBCNT n;
+	REBINT result;
+
+	base = *path;
+	if (WILD_PATH(path)) {
+		// Split to the directory and the name pattern:
+		REBYTE *bp = VAL_BIN(path);
+		for (n = VAL_TAIL(path); n > VAL_INDEX(path) && bp[n-1] != '/'; n--);
+		wild = *path;
+		VAL_INDEX(&wild) = n;
+		pattern = &wild;
+		if (n > VAL_INDEX(path))
+			Set_Series(REB_FILE, &base, Copy_String(VAL_SERIES(path), VAL_INDEX(path), n - VAL_INDEX(path)));
+		else
+			Set_Series(REB_FILE, &base, Copy_Bytes(cb_cast("./"), 2));
+	}
+
+	Init_Dir_Path(dir, &base, 1, POL_READ);
+	result = Read_Dir(dir, files, 0, pattern, subdirs, opts);
+
+	for (n = 0; subdirs && result >= 0 && n < SERIES_TAIL(subdirs); n++) {
+		rel = BLK_SKIP(subdirs, n);
+		full = Copy_String(VAL_SERIES(&base), VAL_INDEX(&base), VAL_LEN(&base));
+		Append_String(full, VAL_SERIES(rel), 0, VAL_TAIL(rel));
+		Set_Series(REB_FILE, &sub_path, full);
+
+		sub = *dir;
+		sub.handle = 0;
+		sub.modes = 0;
+		sub.error = 0;
+		Init_Dir_Path(&sub, &sub_path, 1, POL_READ);
+		Read_Dir(&sub, files, VAL_SERIES(rel), pattern, subdirs, opts);
+	}
+	if (subdirs) Free_Series(subdirs);
+
+	return result;
+}
+
+
 /***********************************************************************
 **
 */	static int Dir_Actor(REBVAL *ds, REBVAL *port_value, REBCNT action)
@@ -194,9 +321,16 @@
 	case A_READ:
 		// !!! ignores /SKIP and /PART, for now !!!
 		if (!IS_BLOCK(data)) {
-			Init_Dir_Path(dir, path, 1, POL_READ);
+			REBCNT opts = 0;
+			if (D_REF(ARG_READ_ALL))  opts |= DIR_INFO;
+			if (D_REF(ARG_READ_DEEP)) opts |= DIR_DEEP;
 			Set_Block(data, Make_Block(7)); // initial guess
-			result = Read_Dir(dir, VAL_SERIES(data));
+			if (opts) {
+				result = Read_Dir_Tree(dir, path, VAL_SERIES(data), opts);
+			} else {
+				Init_Dir_Path(dir, path, 1, POL_READ);
+				result = Read_Dir(dir, VAL_SERIES(data), 0, 0, 0, 0);
+			}
 
 			// don't throw an error if the original path contains wildcard chars * or ?
 			if (result < 0 && !(result == -RFE_OPEN_FAIL && WILD_PATH(path)) ) {
@@ -244,7 +378,7 @@ create:
 		// If port is already open, just ignore it. 
 		Init_Dir_Path(dir, path, 1, POL_READ);
 		Set_Block(data, Make_Block(7));
-		result = Read_Dir(dir, VAL_SERIES(data));
+		result = Read_Dir(dir, VAL_SERIES(data), 0, 0, 0, 0);
 		if (result < 0) Trap_Port(RE_CANNOT_OPEN, port, dir->error);
 		SET_OPEN(dir);
 		break;
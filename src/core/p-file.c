@@ -35,6 +35,13 @@
 #define READ_MAX ((REBCNT)(-1))
 #define HL64(v) (v##l + (v##h << 32))
 #define MAX_READ_MASK 0x7FFFFFFF // max size per chunk
+#define MOLD_CHUNK_SIZE 0x8000   // size of chunks used when molding into a file
+
+typedef struct file_mold_stream {  // target of Flush_File_Mold
+	REBSER *port;
+	REBREQ *file;
+	REBOOL  opened;                // the file was opened just for this WRITE
+} FILE_MOLD;
 
 
 /***********************************************************************
@@ -92,7 +99,7 @@
 
 /***********************************************************************
 **
-*/	static REBOOL Set_File_Mode_Value(REBREQ *file, REBCNT mode, REBVAL *ret)
+*/	REBOOL Set_File_Mode_Value(REBREQ *file, REBCNT mode, REBVAL *ret)
 /*
 **		Set a value with file data according specified mode 
 **
@@ -298,24 +305,86 @@ resize:
 
 /***********************************************************************
 **
-*/	static void Write_File_Port(REBREQ *file, REBVAL *data, REBCNT len, REBCNT args)
+*/	static void Flush_File_Mold(REB_MOLD *mold)
+/*
+**		Writes the content of the mold buffer into the file
+**		and resets the buffer. A failed write stops the molding
+**		with an error (the next write would clear file->error).
+**
+***********************************************************************/
+{
+	FILE_MOLD *out = (FILE_MOLD*)mold->stream;
+	REBREQ *file = out->file;
+	REBSER *ser = mold->series;
+	REBINT error;
+
+	if (SERIES_TAIL(ser) > 0) {
+		file->data = BIN_HEAD(ser);
+		file->length = SERIES_TAIL(ser);
+		OS_Do_Device(file, RDC_WRITE);
+		file->file.index += file->actual;
+	}
+	RESET_SERIES(ser);
+
+	if (file->error) {
+		error = (REBINT)file->error; // store error value, before closing the file!
+		if (out->opened) {
+			OS_Do_Device(file, RDC_CLOSE);
+			Release_Port_State(out->port);
+		}
+		Trap_Port(RE_WRITE_ERROR, out->port, error);
+	}
+}
+
+
+/***********************************************************************
+**
+*/	static void Write_File_Mold(REBSER *port, REBREQ *file, REBVAL *data, REBCNT args, REBOOL opened)
+/*
+**		Molds the value (or forms it with /lines) directly into the file.
+**		The mold buffer is flushed each time it grows over MOLD_CHUNK_SIZE,
+**		so memory use does not depend on the size of the output.
+**
+***********************************************************************/
+{
+	REB_MOLD mo = {0};
+	FILE_MOLD out;
+
+	out.port = port;
+	out.file = file;
+	out.opened = opened;
+
+	if (args & AM_WRITE_LINES) SET_FLAG(mo.opts, MOPT_LINES);
+	if (args & AM_WRITE_ALL) SET_FLAG(mo.opts, MOPT_MOLD_ALL);
+	if ((args & AM_WRITE_ONLY) && IS_BLOCK(data)) SET_FLAG(mo.opts, MOPT_ONLY);
+
+	Reset_Mold(&mo);
+	mo.chunk  = MOLD_CHUNK_SIZE;
+	mo.flush  = Flush_File_Mold;
+	mo.stream = &out;
+
+	Mold_Value(&mo, data, !(args & AM_WRITE_LINES));
+	Flush_File_Mold(&mo);
+
+	file->actual = 0; // the index was already updated with each chunk
+}
+
+
+/***********************************************************************
+**
+*/	static void Write_File_Port(REBSER *port, REBREQ *file, REBVAL *data, REBCNT len, REBCNT args, REBOOL opened)
 /*
 ***********************************************************************/
 {
 	REBOOL lines = (args & AM_WRITE_LINES) != 0;
 	REBINT n = 0;
 
-	if (IS_BLOCK(data)) {
-		// Form the values of the block
-		// !! Could be made more efficient if we broke the FORM
-		// into 32K chunks for writing.
-		REB_MOLD mo = {0};
-		Reset_Mold(&mo);
-		if (lines) mo.opts = 1 << MOPT_LINES;
-		Mold_Value(&mo, data, 0);
-		Set_String(data, mo.series); // fall into next section
-		len = SERIES_TAIL(mo.series);
-	} else if (lines) {
+	if (!(IS_BINARY(data) || IS_STRING(data) || IS_CHAR(data))) {
+		Write_File_Mold(port, file, data, args, opened);
+		return;
+	}
+
+	if (lines) {
 		// if there was: WRITE/LINES "string"
 		// append temporary CRLF on Windows or LF on Posix
 		// @@ https://github.com/rebol/rebol-issues/issues/2102
@@ -504,7 +573,9 @@ resize:
 		args = Find_Refines(ds, ALL_WRITE_REFS);
 		spec = D_ARG(2); // data (binary, string, char or block)
 
-		if (!(IS_BINARY(spec) || IS_STRING(spec) || IS_CHAR(spec) || (IS_BLOCK(spec) && (args & AM_WRITE_LINES)))) {
+		// Other values are molded directly into the file by Write_File_Port,
+		// only a partial write needs the whole molded result first.
+		if (!(IS_BINARY(spec) || IS_STRING(spec) || IS_CHAR(spec)) && (args & AM_WRITE_PART)) {
 			//Trap1(RE_INVALID_ARG, spec);
 			REB_MOLD mo = {0};
 			Reset_Mold(&mo);
@@ -532,14 +603,14 @@ resize:
 		}
 		if (args & AM_WRITE_SEEK) Set_Seek(file, D_ARG(ARG_WRITE_INDEX));
 
-		len = IS_CHAR(spec) ? 0 : VAL_LEN(spec);
+		len = (IS_BINARY(spec) || IS_STRING(spec)) ? VAL_LEN(spec) : 0;
 		// Determine length. Clip /PART to size of string if needed.
 		if (args & AM_WRITE_PART) {
 			REBCNT n = Int32s(D_ARG(ARG_WRITE_LENGTH), 0);
 			if (n <= len) len = n;
 		}
 
-		Write_File_Port(file, spec, len, args);
+		Write_File_Port(port, file, spec, len, args, opened);
 
 		file->file.index += file->actual;
 
@@ -573,6 +644,8 @@ resize:
 
 	case A_CLOSE:
 		if (IS_OPEN(file)) {
+			// Its handle is still used by a net WRITE of the file:
+			if (GET_FLAG(file->modes, RFM_SENDING)) Trap_Port(RE_CANNOT_CLOSE, port, -16);
 			OS_Do_Device(file, RDC_CLOSE);
 			Release_Port_State(port);
 		}
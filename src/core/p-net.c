@@ -34,6 +34,7 @@
 #include "reb-evtypes.h"
 
 #define NET_BUF_SIZE 32*1024
+#define NET_BUF_MAX  1024*1024	// limit of the adaptive receive buffer size
 
 enum Transport_Types {
 	TRANSPORT_TCP,
@@ -172,6 +173,147 @@ enum Transport_Types {
 	OS_Free(nsock); // allocated by dev_net.c (MT issues?)
 }
 
+
+/***********************************************************************
+**
+*/	static REBREQ *Get_File_Request(REBVAL *port_value)
+/*
+**		Returns the request of an open file port or zero.
+**
+***********************************************************************/
+{
+	REBSER *port = Validate_Port_Value(port_value);
+	REBVAL *state = BLK_SKIP(port, STD_PORT_STATE);
+	REBREQ *file;
+
+	if (!IS_HANDLE(state) || VAL_HANDLE_TYPE(state) != SYM_PORT_STATEX) return 0;
+	file = (REBREQ *)VAL_HANDLE_CONTEXT_DATA(state);
+	if (file->device != RDI_FILE || !IS_OPEN(file)) return 0;
+	return file;
+}
+
+/***********************************************************************
+**
+*/	static void Finish_File_Send(REBVAL *data, REBREQ *sock)
+/*
+**		Ends the RSM_SENDFILE transfer of the file port in the port
+**		data (done, failed or closed). The file index is moved past
+**		the sent part (as if it was read) and the file may be closed.
+**
+***********************************************************************/
+{
+	REBREQ *file;
+
+	if (!IS_PORT(data) || !(file = Get_File_Request(data))) return;
+	if (!GET_FLAG(file->modes, RFM_SENDING)) return;
+	CLR_FLAG(file->modes, RFM_SENDING);
+	file->file.index = sock->net.file_offset;
+	SET_FLAG(file->modes, RFM_RESEEK);
+}
+
+
+/***********************************************************************
+**
+*/	static void Adapt_Read_Size(REBREQ *sock)
+/*
+**		Adjust the size used to extend the receive buffer after a read.
+**		It is doubled when the read filled all available space (more
+**		data are probably waiting) and halved when it was mostly unused.
+**
+***********************************************************************/
+{
+	REBCNT size = sock->net.read_size ? sock->net.read_size : NET_BUF_SIZE;
+
+	if (sock->actual >= sock->length) {
+		if (size < NET_BUF_MAX) size *= 2;
+	}
+	else if (sock->actual < size / 4 && size > NET_BUF_SIZE) size /= 2;
+
+	sock->net.read_size = size;
+}
+
+
+/***********************************************************************
+**
+*/	static void Append_Datagrams(REBSER *blk, REBREQ *sock)
+/*
+**		Append datagrams received in the UDP batch mode to the block
+**		as: binary remote-ip remote-port
+**
+***********************************************************************/
+{
+	REBNETB *batch = (REBNETB *)sock->net.batch;
+	REBVAL *val;
+	REBCNT n;
+
+	if (!batch) return;
+	for (n = 0; n < batch->count; n++) {
+		val = Append_Value(blk);
+		Set_Binary(val, Copy_Bytes(batch->data[n], batch->info[n].length));
+		VAL_SET_LINE(val);
+		Set_Tuple(Append_Value(blk), (REBYTE *)&batch->info[n].remote_ip, 4);
+		SET_INTEGER(Append_Value(blk), batch->info[n].remote_port);
+	}
+	batch->count = 0;
+}
+
+
+/***********************************************************************
+**
+*/	static REBIOV *Gather_Write_Data(REBVAL *arg, REBCNT *total)
+/*
+**		Prepare a gather write of binaries and strings of a block.
+**		Only wide strings are encoded (to UTF-8), other data are sent
+**		from their own series. The arg is replaced with a block,
+**		which keeps all the data GC safe (its last value is a binary
+**		with the REBIOV list). Returns the list and its total size.
+**
+***********************************************************************/
+{
+	REBCNT count = VAL_LEN(arg);
+	REBSER *blk = Make_Block(count + 1);
+	REBSER *list = Make_Binary((count + 1) * sizeof(REBIOV));
+	REBIOV *iov = (REBIOV *)BIN_HEAD(list);
+	REBVAL *val;
+	REBSER *ser;
+	REBU64 size = 0;
+	REBCNT n = 0;
+
+	for (val = VAL_BLK_DATA(arg); NOT_END(val); val++) {
+		if (IS_BINARY(val)) {
+			*Append_Value(blk) = *val;
+			iov[n].data = VAL_BIN_DATA(val);
+			iov[n].length = VAL_LEN(val);
+		}
+		else if (ANY_STRING(val) && VAL_BYTE_SIZE(val)) {
+			// Byte strings are already UTF-8 (or ASCII), no copy needed:
+			*Append_Value(blk) = *val;
+			iov[n].data = VAL_BIN_DATA(val);
+			iov[n].length = VAL_LEN(val);
+		}
+		else if (ANY_STRING(val)) {
+			ser = Encode_UTF8_String(VAL_UNI_DATA(val), VAL_LEN(val), TRUE, 0);
+			Set_Binary(Append_Value(blk), ser);
+			iov[n].data = BIN_HEAD(ser);
+			iov[n].length = BIN_LEN(ser);
+		}
+		else Trap1(RE_INVALID_ARG, val);
+		size += iov[n].length;
+		if (iov[n].length > 0) n++;
+	}
+	if (size > MAX_U32) Trap1(RE_SIZE_LIMIT, arg);
+
+	iov[n].data = 0;
+	iov[n].length = 0;
+	SERIES_TAIL(list) = (n + 1) * sizeof(REBIOV);
+	Set_Binary(Append_Value(blk), list);
+	Set_Block(arg, blk);
+
+	*total = (REBCNT)size;
+	return iov;
+}
+
+
 /***********************************************************************
 **
 */	static int Transport_Actor(REBVAL *ds, REBVAL *port_value, REBCNT action, enum Transport_Types proto)
@@ -267,9 +409,15 @@ enum Transport_Types {
 		// This is normally called by the WAKE-UP function.
 		arg = OFV(port, STD_PORT_DATA);
 		if (sock->command == RDC_READ) {
-			if (ANY_BINSTR(arg)) VAL_TAIL(arg) += sock->actual;
+			if (ANY_BINSTR(arg) && sock->actual) {
+				VAL_TAIL(arg) += sock->actual;
+				Adapt_Read_Size(sock);
+			}
+			else if (IS_BLOCK(arg) && GET_FLAG(sock->state, RSM_BATCH))
+				Append_Datagrams(VAL_SERIES(arg), sock);
 		}
 		else if (sock->command == RDC_WRITE) {
+			Finish_File_Send(arg, sock);
 			SET_NONE(arg);  // Write is done.
 		}
 		return R_NONE;
@@ -282,23 +430,37 @@ enum Transport_Types {
 				&& !GET_FLAG(sock->state, RSM_CONNECT))
 			Trap_Port(RE_NOT_CONNECTED, port, -15);
 
-		// Setup the read buffer (allocate a buffer if needed):
 		arg = OFV(port, STD_PORT_DATA);
-		if (!IS_STRING(arg) && !IS_BINARY(arg)) {
-			Set_Binary(arg, Make_Binary(NET_BUF_SIZE));
-		}
-		ser = VAL_SERIES(arg);
-		sock->length = SERIES_AVAIL(ser); // space available
-		if (sock->length < NET_BUF_SIZE/2) Extend_Series(ser, NET_BUF_SIZE);
-		sock->length = SERIES_AVAIL(ser);
-		sock->data = STR_TAIL(ser); // write at tail
-		//if (SERIES_TAIL(ser) == 0)
 		sock->actual = 0;  // Actual for THIS read, not for total.
 
+		if (IS_BLOCK(arg) && GET_FLAG(sock->modes, RST_UDP)) {
+			// Batch mode: all waiting datagrams are received at once
+			// (into the device buffer) and appended to the block on update.
+			SET_FLAG(sock->state, RSM_BATCH);
+			sock->data = 0;
+			sock->length = 0;
+		}
+		else {
+			// Setup the read buffer (allocate a buffer if needed):
+			len = sock->net.read_size ? sock->net.read_size : NET_BUF_SIZE;
+			CLR_FLAG(sock->state, RSM_BATCH);
+			if (!IS_STRING(arg) && !IS_BINARY(arg)) {
+				Set_Binary(arg, Make_Binary(len));
+			}
+			ser = VAL_SERIES(arg);
+			if (SERIES_AVAIL(ser) < len/2) Extend_Series(ser, len);
+			sock->length = SERIES_AVAIL(ser); // space available
+			sock->data = STR_TAIL(ser); // write at tail
+		}
+
 		//Print("(max read length %d)", sock->length);
 		result = OS_Do_Device(sock, RDC_READ); // recv can happen immediately
-		if (GET_FLAG(sock->modes, RST_UDP && result == 0))
+		if (GET_FLAG(sock->modes, RST_UDP) && result == 0 && ANY_BINSTR(arg)) {
+			// Datagram was received immediately (the update must not add it again):
 			VAL_TAIL(arg) += sock->actual;
+			Adapt_Read_Size(sock);
+			sock->actual = 0;
+		}
 		if (result < 0)
 			Trap_Port(RE_READ_ERROR, port, sock->error);
 		
@@ -313,22 +475,70 @@ enum Transport_Types {
 				&& !GET_FLAG(sock->state, RSM_CONNECT))
 			Trap_Port(RE_NOT_CONNECTED, port, -15);
 
-		// Determine length. Clip /PART to size of string if needed.
 		spec = D_ARG(2);
-		len = VAL_LEN(spec);
-		if (refs & AM_WRITE_PART) {
-			REBCNT n = Int32s(D_ARG(ARG_WRITE_LENGTH), 0);
-			if (n <= len) len = n;
+		// A file send still in progress cannot be replaced by another write
+		// (its file position would be lost). The previous completed one ends:
+		if (GET_FLAG(sock->flags, RRF_PENDING) && sock->command == RDC_WRITE
+				&& GET_FLAG(sock->state, RSM_SENDFILE))
+			Trap_Port(RE_WRITE_ERROR, port, -16);
+		Finish_File_Send(OFV(port, STD_PORT_DATA), sock);
+		CLR_FLAG(sock->state, RSM_SENDFILE);
+		CLR_FLAG(sock->state, RSM_GATHER);
+
+		if (IS_PORT(spec)) {
+			// Send content of an open file port (without copying it
+			// through a series). Optional /seek and /part are the
+			// file position and length. The file index is moved past
+			// the sent part when the transfer ends and the file port
+			// cannot be closed until then.
+			REBREQ *file = Get_File_Request(spec);
+			REBI64 offset, size;
+			if (!file || GET_FLAG(sock->modes, RST_UDP) || GET_FLAG(file->modes, RFM_SENDING))
+				Trap1(RE_INVALID_ARG, spec);
+			size = MAX(file->file.size, 0);
+			offset = (refs & AM_WRITE_SEEK) ? Int64s(D_ARG(ARG_WRITE_INDEX), 0) : file->file.index;
+			if (offset > size) offset = size;
+			size -= offset;
+			if (refs & AM_WRITE_PART) {
+				REBI64 n = Int64s(D_ARG(ARG_WRITE_LENGTH), 0);
+				if (n < size) size = n;
+			}
+			if (size > MAX_U32) Trap1(RE_SIZE_LIMIT, spec);
+			len = (REBCNT)size;
+#ifdef TO_WINDOWS
+			sock->net.file_handle = file->handle;
+#else
+			sock->net.file_id = file->id;
+#endif
+			sock->net.file_offset = offset;
+			sock->data = 0;
+			SET_FLAG(file->modes, RFM_SENDING);
+			SET_FLAG(sock->state, RSM_SENDFILE);
+		}
+		else if (IS_BLOCK(spec)) {
+			// Send all binaries (and strings) of the block with a single
+			// gather write, so they do not need to be joined first.
+			sock->data = (REBYTE *)Gather_Write_Data(spec, &len);
+			SET_FLAG(sock->state, RSM_GATHER);
+		}
+		else {
+			// Determine length. Clip /PART to size of string if needed.
+			len = VAL_LEN(spec);
+			if (refs & AM_WRITE_PART) {
+				REBCNT n = Int32s(D_ARG(ARG_WRITE_LENGTH), 0);
+				if (n <= len) len = n;
+			}
+			sock->data = VAL_BIN_DATA(spec);
 		}
 
 		// Setup the write:
 		*OFV(port, STD_PORT_DATA) = *spec;	// keep it GC safe
 		sock->length = len;
-		sock->data = VAL_BIN_DATA(spec);
 		sock->actual = 0;
 
 		//Print("(write length %d)", len);
 		result = OS_Do_Device(sock, RDC_WRITE); // send can happen immediately
+		if (result < 0 || result == DR_DONE) Finish_File_Send(spec, sock);
 		if (result < 0) Trap_Port(RE_WRITE_ERROR, port, sock->error);
 		if (result == DR_DONE) SET_NONE(OFV(port, STD_PORT_DATA));
 		break;
@@ -359,6 +569,7 @@ enum Transport_Types {
 
 	case A_CLOSE:
 		if (IS_OPEN(sock)) {
+			Finish_File_Send(OFV(port, STD_PORT_DATA), sock);
             if (OS_Do_Device(sock, RDC_CLOSE) < 0) {
                 Trap_Port(RE_CANNOT_CLOSE, port, sock->error);
             }
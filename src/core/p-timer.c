@@ -3,7 +3,7 @@
 **  REBOL [R3] Language Interpreter and Run-time Environment
 **
 **  Copyright 2012 REBOL Technologies
-**  Copyright 2012-2025 Rebol Open Source Contributors
+**  Copyright 2012-2026 Rebol Open Source Contributors
 **  REBOL is a trademark of REBOL Technologies
 **
 **  Licensed under the Apache License, Version 2.0 (the "License");
@@ -23,96 +23,445 @@
 **  Module:  p-timer.c
 **  Summary: timer port interface
 **  Section: ports
-**  Author:  Carl Sassenrath
-**  Notes:   NOT IMPLEMENTED
+**  Author:  Carl Sassenrath, Rebol Open Source Contributors
+**  Notes:
+**
+**	Usage:
+**
+**		t: open timer://
+**		t/awake: func [event] [print "timer!" true]
+**		write t 0:0:10         ; one-shot timer (also integer or decimal seconds)
+**		write t [0:0:1 0:0:1]  ; first delay and period of a periodic timer
+**		read t                 ; time remaining to the next expiration or none
+**		clear t                ; cancel the timer
+**		wait t
+**
+**	Armed timers are kept in a hierarchical timing wheel with
+**	millisecond ticks (WHEEL_LEVELS levels of WHEEL_SIZE slots), so
+**	arming and cancelling a timer is O(1) regardless of the number of
+**	outstanding timers. Timers far in the future are placed in an upper
+**	level and moved (cascaded) to lower levels as the wheel turns.
+**
+**	The wheel is advanced by Wait_Ports, which also limits its sleep
+**	by Next_Timer_Delay. An expired timer sends a TIME event with the
+**	timer port to the system port queue.
+**
+**	Ports of armed one-shot timers are held in the TASK_TIMERS block
+**	(parallel to the timer records), so they are safe from GC until
+**	they expire. Periodic timers do not hold their ports: when such a
+**	port is not referenced elsewhere, the GC cancels its timer
+**	(Sweep_Timers). The port state holds the index of its timer record.
 **
 ***********************************************************************/
+
+#include "sys-core.h"
+#include "reb-evtypes.h"
+
+#define WHEEL_BITS   8
+#define WHEEL_SIZE   (1 << WHEEL_BITS)
+#define WHEEL_MASK   (WHEEL_SIZE - 1)
+#define WHEEL_LEVELS 4
+#define WHEEL_SPAN   (((REBI64)1 << (WHEEL_BITS * WHEEL_LEVELS)) - 1)
+
+typedef struct rebol_timer {
+	REBI64 due;         // expiration time (ms)
+	REBI64 period;      // zero for one-shot timers
+	REBCNT next;        // slot list links (record index + 1, 0 = none)
+	REBCNT prev;
+	REBCNT slot;        // wheel slot (NOT_FOUND when the record is free)
+	REBSER *port;       // timer port (not GC safe for periodic timers)
+} REBTMR;
+
+static REBSER *Timer_Records;  // REBTMR records (ports are in TASK_TIMERS)
+static REBCNT  Timer_Free;     // free record list (index + 1)
+static REBCNT  Timer_Count;    // number of armed timers
+static REBI64  Wheel_Time;     // current wheel time (ms)
+static REBCNT  Wheel[WHEEL_LEVELS * WHEEL_SIZE]; // slot lists (index + 1)
+
+#define TIMER(n)      ((REBTMR *)SERIES_DATA(Timer_Records) + (n))
+#define TIMER_PORT(n) BLK_SKIP(TASK_TIMERS_SER, n)
+#define TASK_TIMERS_SER VAL_SERIES(TASK_TIMERS)
+
+
+/***********************************************************************
+**
+*/	static REBI64 Timer_Now(void)
 /*
-	General idea of usage:
+***********************************************************************/
+{
+	return OS_Delta_Time(0, 0) / 1000;
+}
 
-	t: open timer://name
-	write t 10	; set timer - also allow: 1.23 1:23
-	wait t
-	clear t		; reset or delete?
-	read t		; get timer value
-	t/awake: func [event] [print "timer!"]
-	one-shot vs restart timer
-*/
 
-#include "sys-core.h"
+/***********************************************************************
+**
+*/	static void Link_Timer(REBCNT n)
+/*
+**		Put the timer record into the wheel slot of its due time.
+**
+***********************************************************************/
+{
+	REBTMR *tmr = TIMER(n);
+	REBI64 due = tmr->due;
+	REBI64 delta;
+	REBCNT level = 0;
+	REBCNT slot;
+
+	if (due <= Wheel_Time) due = Wheel_Time + 1; // expire on next tick
+	delta = due - Wheel_Time;
+	if (delta > WHEEL_SPAN) {
+		delta = WHEEL_SPAN;
+		due = Wheel_Time + WHEEL_SPAN; // will be linked again when reached
+	}
+
+	while (level < WHEEL_LEVELS - 1 && delta >= ((REBI64)1 << (WHEEL_BITS * (level + 1)))) level++;
+	slot = level * WHEEL_SIZE + (REBCNT)((due >> (WHEEL_BITS * level)) & WHEEL_MASK);
+
+	tmr->slot = slot;
+	tmr->prev = 0;
+	tmr->next = Wheel[slot];
+	if (tmr->next) TIMER(tmr->next - 1)->prev = n + 1;
+	Wheel[slot] = n + 1;
+}
+
+
+/***********************************************************************
+**
+*/	static void Unlink_Timer(REBCNT n)
+/*
+***********************************************************************/
+{
+	REBTMR *tmr = TIMER(n);
+
+	if (tmr->prev) TIMER(tmr->prev - 1)->next = tmr->next;
+	else Wheel[tmr->slot] = tmr->next;
+	if (tmr->next) TIMER(tmr->next - 1)->prev = tmr->prev;
+	tmr->next = tmr->prev = 0;
+}
 
 
 /***********************************************************************
 **
-*/	static int Event_Actor(REBVAL *ds, REBSER *port, REBCNT action)
+*/	static void Free_Timer(REBCNT n)
 /*
 ***********************************************************************/
 {
-	REBVAL *spec;
-	REBVAL *state;
-	REBCNT result;
+	REBTMR *tmr = TIMER(n);
+
+	SET_NONE(OFV(tmr->port, STD_PORT_STATE));
+	SET_NONE(TIMER_PORT(n));
+	tmr->port = 0;
+	tmr->slot = NOT_FOUND;
+	tmr->next = Timer_Free;
+	Timer_Free = n + 1;
+	Timer_Count--;
+}
+
+
+/***********************************************************************
+**
+*/	static REBINT Port_Timer(REBSER *port)
+/*
+**		Returns index of the timer record armed by the port or -1.
+**
+***********************************************************************/
+{
+	REBVAL *state = BLK_SKIP(port, STD_PORT_STATE);
+	REBINT n;
+
+	if (!IS_INTEGER(state)) return -1;
+	n = VAL_INT32(state) - 1;
+	if (n < 0 || n >= (REBINT)SERIES_TAIL(Timer_Records)) return -1;
+	if (TIMER(n)->slot == NOT_FOUND) return -1;
+	if (TIMER(n)->port != port) return -1;
+	return n;
+}
+
+
+/***********************************************************************
+**
+*/	static void Cancel_Timer(REBSER *port)
+/*
+***********************************************************************/
+{
+	REBINT n = Port_Timer(port);
+
+	if (n < 0) return;
+	Unlink_Timer(n);
+	Free_Timer(n);
+}
+
+
+/***********************************************************************
+**
+*/	static void Arm_Timer(REBVAL *port_value, REBI64 delay, REBI64 period)
+/*
+***********************************************************************/
+{
+	REBSER *port = VAL_PORT(port_value);
+	REBTMR *tmr;
+	REBCNT n;
+
+	Cancel_Timer(port);
+
+	// Keep the wheel time current, when no timer was running:
+	if (Timer_Count == 0) Wheel_Time = Timer_Now();
+
+	if (Timer_Free) {
+		n = Timer_Free - 1;
+		Timer_Free = TIMER(n)->next;
+	}
+	else {
+		n = SERIES_TAIL(Timer_Records);
+		EXPAND_SERIES_TAIL(Timer_Records, 1);
+		Append_Value(TASK_TIMERS_SER);
+	}
+
+	tmr = TIMER(n);
+	tmr->due = Timer_Now() + delay;
+	tmr->period = period;
+	tmr->port = port;
+	if (period > 0) SET_NONE(TIMER_PORT(n));
+	else *TIMER_PORT(n) = *port_value;
+	SET_INTEGER(OFV(port, STD_PORT_STATE), n + 1);
+	Timer_Count++;
+	Link_Timer(n);
+}
+
+
+/***********************************************************************
+**
+*/	static void Expire_Timer(REBCNT n)
+/*
+**		Send the TIME event to the port. Re-arm a periodic timer.
+**		When the event cannot be queued, retry on the next tick.
+**
+***********************************************************************/
+{
+	REBTMR *tmr = TIMER(n);
+	REBVAL *evt = Append_Event();
+
+	if (!evt) {
+		Link_Timer(n); // still due
+		return;
+	}
+	VAL_SET(evt, REB_EVENT);
+	VAL_EVENT_TYPE(evt) = EVT_TIME;
+	VAL_EVENT_FLAGS(evt) = 0;
+	VAL_EVENT_WIN(evt) = 0;
+	VAL_EVENT_MODEL(evt) = EVM_PORT;
+	VAL_EVENT_SER(evt) = tmr->port;
+	VAL_EVENT_DATA(evt) = 0;
+
+	if (tmr->period > 0) {
+		tmr->due += tmr->period;
+		if (tmr->due <= Wheel_Time) tmr->due = Wheel_Time + tmr->period; // skip missed ticks
+		Link_Timer(n);
+	}
+	else Free_Timer(n);
+}
+
+
+/***********************************************************************
+**
+*/	static REBI64 Next_Wheel_Tick(void)
+/*
+**		Returns the wheel time of the next expiration or cascade.
+**		Nothing happens on the ticks before it, so they are skipped.
+**
+***********************************************************************/
+{
+	REBI64 next = 0, tick;
+	REBCNT level, shift, base, k;
+
+	for (level = 0; level < WHEEL_LEVELS; level++) {
+		shift = WHEEL_BITS * level;
+		// Upper levels cannot have anything before their next boundary:
+		if (next && next <= (((Wheel_Time >> shift) + 1) << shift)) break;
+		// A full turn of an upper level is its current slot again:
+		base = (REBCNT)((Wheel_Time >> shift) & WHEEL_MASK);
+		for (k = 1; k <= WHEEL_SIZE; k++) {
+			if (Wheel[level * WHEEL_SIZE + ((base + k) & WHEEL_MASK)]) break;
+		}
+		if (k > WHEEL_SIZE) continue;
+		tick = ((Wheel_Time >> shift) + k) << shift;
+		if (!next || tick < next) next = tick;
+	}
+	return next ? next : Wheel_Time + WHEEL_SPAN;
+}
+
+
+/***********************************************************************
+**
+*/	void Fire_Timers(void)
+/*
+**		Advance the timing wheel to the current time and expire all
+**		due timers. Called by Wait_Ports.
+**
+***********************************************************************/
+{
+	REBI64 now, tick;
+	REBCNT level, top, slot, n, next;
+
+	if (!Timer_Count) return;
+	now = Timer_Now();
+
+	while (Timer_Count && (tick = Next_Wheel_Tick()) <= now) {
+		Wheel_Time = tick;
+
+		// When lower levels wrap, cascade slots of upper levels down
+		// (the highest first, as it may refill the lower ones):
+		for (top = 0; top + 1 < WHEEL_LEVELS; top++) {
+			if (Wheel_Time & (((REBI64)1 << (WHEEL_BITS * (top + 1))) - 1)) break;
+		}
+		for (level = top; level > 0; level--) {
+			slot = level * WHEEL_SIZE + (REBCNT)((Wheel_Time >> (WHEEL_BITS * level)) & WHEEL_MASK);
+			n = Wheel[slot];
+			Wheel[slot] = 0;
+			for (; n; n = next) {
+				next = TIMER(n - 1)->next;
+				Link_Timer(n - 1);
+			}
+		}
+
+		slot = (REBCNT)(Wheel_Time & WHEEL_MASK);
+		n = Wheel[slot];
+		Wheel[slot] = 0;
+		for (; n; n = next) {
+			next = TIMER(n - 1)->next;
+			TIMER(n - 1)->next = TIMER(n - 1)->prev = 0;
+			if (TIMER(n - 1)->due > Wheel_Time) Link_Timer(n - 1); // clamped far timer
+			else Expire_Timer(n - 1);
+		}
+	}
+	if (Wheel_Time < now) Wheel_Time = now;
+}
+
+
+/***********************************************************************
+**
+*/	REBINT Next_Timer_Delay(void)
+/*
+**		Returns milliseconds to the next wheel event (an expiration or
+**		a cascade), or -1 when no timer is armed.
+**
+***********************************************************************/
+{
+	REBI64 delay;
+
+	if (!Timer_Count) return -1;
+
+	delay = Next_Wheel_Tick() - Timer_Now();
+	return (REBINT)MAX(MIN(delay, MAX_I32), 0);
+}
+
+
+/***********************************************************************
+**
+*/	void Sweep_Timers(void)
+/*
+**		Cancel periodic timers of ports which were not marked
+**		(called by the GC before it sweeps series).
+**
+***********************************************************************/
+{
+	REBTMR *tmr;
+	REBCNT n;
+
+	if (!Timer_Count) return;
+
+	for (n = 0; n < SERIES_TAIL(Timer_Records); n++) {
+		tmr = TIMER(n);
+		if (tmr->slot == NOT_FOUND || IS_MARK_SERIES(tmr->port)) continue;
+		Unlink_Timer(n);
+		Free_Timer(n);
+	}
+}
+
+
+/***********************************************************************
+**
+*/	static REBI64 Timer_Millisecs(REBVAL *val)
+/*
+***********************************************************************/
+{
+	REBI64 ms = 0;
+
+	switch (VAL_TYPE(val)) {
+	case REB_INTEGER:
+		ms = 1000 * VAL_INT64(val);
+		break;
+	case REB_DECIMAL:
+		ms = (REBI64)(1000 * VAL_DECIMAL(val));
+		break;
+	case REB_TIME:
+		ms = VAL_TIME(val) / (SEC_SEC / 1000);
+		break;
+	default:
+		Trap_Arg(val);
+	}
+	if (ms < 0) Trap_Range(val);
+	return ms;
+}
+
+
+/***********************************************************************
+**
+*/	static int Timer_Actor(REBVAL *ds, REBVAL *port_value, REBCNT action)
+/*
+**		Internal port handler for timers.
+**
+***********************************************************************/
+{
+	REBSER *port;
 	REBVAL *arg;
-	REBVAL save_port;
+	REBINT n;
+	REBI64 delay, period = 0;
 
-	Validate_Port(port, action);
+	port = Validate_Port_Value(port_value);
 
 	arg = D_ARG(2);
 	*D_RET = *D_ARG(1);
 
-	// Validate and fetch relevant PORT fields:
-	state = BLK_SKIP(port, STD_PORT_STATE);
-	spec  = BLK_SKIP(port, STD_PORT_SPEC);
-	if (!IS_OBJECT(spec)) Trap1(RE_INVALID_SPEC, spec);
-
-	// Get or setup internal state data:
-	if (!IS_BLOCK(state)) Set_Block(state, Make_Block(127));
-
 	switch (action) {
 
 	case A_UPDATE:
 		return R_NONE;
 
-	// Normal block actions done on events:
-	case A_POKE:
-		if (!IS_EVENT(D_ARG(3))) Trap_Arg(D_ARG(3));
-		goto act_blk;
-	case A_INSERT:
-	case A_APPEND:
-	//case A_PATH:		// not allowed: port/foo is port object field access
-	//case A_PATH_SET:	// not allowed: above
-		if (!IS_EVENT(arg)) Trap_Arg(arg);
-	case A_PICK:
-act_blk:
-		save_port = *D_ARG(1); // save for return
-		*D_ARG(1) = *state;
-		result = T_Block(ds, action);
-		SET_FLAG(Eval_Signals, SIG_EVENT_PORT);
-		if (action == A_INSERT || action == A_APPEND || action == A_REMOVE) {
-			*D_RET = save_port;
-			break;
-		}
-		return result; // return condition
+	case A_OPEN:
+	case A_CLOSE:
+		Cancel_Timer(port);
+		break;
 
-	case A_CLEAR:
-		VAL_TAIL(state) = 0;
-		VAL_BLK_TERM(state);
-		CLR_FLAG(Eval_Signals, SIG_EVENT_PORT);
+	case A_OPENQ:
+		return R_TRUE;
+
+	case A_WRITE:
+		if (IS_BLOCK(arg)) {
+			REBVAL *val = VAL_BLK_DATA(arg);
+			if (IS_END(val)) Trap_Arg(arg);
+			delay = Timer_Millisecs(val);
+			if (NOT_END(val + 1)) period = Timer_Millisecs(val + 1);
+		}
+		else delay = Timer_Millisecs(arg);
+		Arm_Timer(D_ARG(1), delay, period);
 		break;
 
-	case A_LENGTHQ:
-		SET_INTEGER(D_RET, VAL_TAIL(state));
+	case A_READ:
+	case A_QUERY:
+		n = Port_Timer(port);
+		if (n < 0) return R_NONE;
+		delay = MAX(TIMER(n)->due - Timer_Now(), 0);
+		VAL_SET(D_RET, REB_TIME);
+		VAL_TIME(D_RET) = delay * (SEC_SEC / 1000);
 		break;
 
-	case A_OPEN:
-		if (!req) { //!!!
-			req = OS_MAKE_DEVREQ(RDI_EVENT);
-			SET_OPEN(req);
-			OS_Do_Device(req, RDC_CONNECT);		// stays queued
-		}
+	case A_CLEAR:
+		Cancel_Timer(port);
 		break;
 
 	default:
-		Trap_Action(REB_PORT, action);
+		Trap1(RE_NO_PORT_ACTION, Get_Action_Word(action));
 	}
 
 	return R_RET;
@@ -125,5 +474,12 @@ act_blk:
 /*
 ***********************************************************************/
 {
-	Register_Scheme(SYM_TIMER, 0, Event_Actor);
+	Timer_Records = Make_Series(64, sizeof(REBTMR), FALSE);
+	KEEP_SERIES(Timer_Records, "timers");
+	Set_Root_Series(TASK_TIMERS, Make_Block(64), cb_cast("timer ports"));
+	Timer_Free = Timer_Count = 0;
+	Wheel_Time = Timer_Now();
+	CLEAR(Wheel, sizeof(Wheel));
+
+	Register_Scheme(SYM_TIMER, 0, Timer_Actor);
 }
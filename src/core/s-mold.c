@@ -84,7 +84,7 @@ enum {
 	REBYTE ender = 0;
 	REBSER *series = mold->series;
 
-	ASSERT2(SERIES_WIDE(series) ==2, 9997);
+	ASSERT2(SERIES_WIDE(series) == 1, 9997);
 
 	va_start(args, fmt);
 
@@ -761,6 +761,8 @@ STOID Mold_Block_Series(REB_MOLD *mold, REBSER *series, REBCNT index, REBYTE *se
 		}
 		line_flag = TRUE;
 		Mold_Value(mold, value, TRUE);
+		// flush before the separator, so New_Indented_Line may still replace it
+		CHECK_MOLD_FLUSH(mold);
 		value++;
 		if (NOT_END(value))
 			Append_Byte(out, (sep[0] == '/') ? '/' : ' ');
@@ -873,7 +875,9 @@ STOID Mold_Simple_Block(REB_MOLD *mold, REBVAL *block, REBCNT len)
 	// Simple molder for error locations. Series must be valid.
 	// Max length in chars must be provided.
 	REBCNT start = SERIES_TAIL(mold->series);
+	REBCNT chunk = mold->chunk;
 
+	mold->chunk = 0; // no flushing, the start position must stay valid
 	while (NOT_END(block)) {
 		if ((SERIES_TAIL(mold->series) - start) > len) break;
 		Mold_Value(mold, block, TRUE);
@@ -886,6 +890,7 @@ STOID Mold_Simple_Block(REB_MOLD *mold, REBVAL *block, REBCNT len)
 		SERIES_TAIL(mold->series) = start + len;
 		Append_Bytes(mold->series, "...");
 	}
+	mold->chunk = chunk;
 }
 
 STOID Form_Block_Series(REBSER *blk, REBCNT index, REB_MOLD *mold, REBSER *frame)
@@ -918,6 +923,7 @@ STOID Form_Block_Series(REBSER *blk, REBCNT index, REB_MOLD *mold, REBSER *frame
 			)
 				Append_Byte(mold->series, ' ');
 		}
+		CHECK_MOLD_FLUSH(mold);
 	}
 }
 
@@ -1023,6 +1029,7 @@ STOID Mold_Map(REBVAL *value, REB_MOLD *mold, REBFLG molded)
 				Append_Byte(mold->series, '\n');
 			}
 			Emit(mold, "V V", val, val+1);
+			CHECK_MOLD_FLUSH(mold);
 		}
 	}
 	mold->indent--;
@@ -1108,6 +1115,7 @@ STOID Mold_Object(REBVAL *value, REB_MOLD *mold)
 				Remove_Last(MOLD_LOOP);
 				return;
 			}
+			CHECK_MOLD_FLUSH(mold);
 		}
 	}
 	mold->indent--;
@@ -1197,8 +1205,8 @@ STOID Mold_Error(REBVAL *value, REB_MOLD *mold, REBFLG molded)
 
 	CHECK_STACK(&len);
 
-	ASSERT2(SERIES_WIDE(mold->series) == sizeof(REBUNI), RP_BAD_SIZE);
 	ASSERT2(ser, RP_NO_BUFFER);
+	ASSERT2(SERIES_WIDE(ser) == 1, RP_BAD_SIZE); // UTF-8 buffer
 
 	// Special handling of string series: {
 	if (ANY_STR(value) && !IS_TAG(value)) { // tag! has different rules!
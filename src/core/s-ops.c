@@ -781,7 +781,7 @@ static REBYTE seed_str[SEED_LEN] = {
 
 	// String series:
 
-	if (IS_PROTECT_SERIES(VAL_SERIES(val))) Trap0(RE_PROTECTED);
+	TRAP_PROTECT(VAL_SERIES(val));
 
 	len = Partial(val, 0, part, 0);
 
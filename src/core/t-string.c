@@ -781,6 +781,8 @@ FORCE_INLINE
 
 	if (n < 0 || (REBCNT)n >= SERIES_TAIL(ser)) return PE_BAD_RANGE;
 
+	TRAP_PROTECT(ser);
+
 	if (IS_CHAR(val)) {
 		c = VAL_CHAR(val);
 		if (c > MAX_CHAR) return PE_BAD_SET;
@@ -802,8 +804,6 @@ FORCE_INLINE
 	else
 		return PE_BAD_SELECT;
 
-	TRAP_PROTECT(ser);
-
 //	if (c > 0x7F || IS_UTF8_SERIES(ser)) {
 //		UTF8_SERIES(ser); // in case we are adding unicode char to ascii series
 //		UTF8_Replace_Codepoint(ser, n, c);
@@ -889,8 +889,8 @@ FORCE_INLINE
 	}
 
 	// Check must be in this order (to avoid checking a non-series value);
-	if (action >= A_TAKE && action <= A_SORT && IS_PROTECT_SERIES(VAL_SERIES(value)))
-		Trap0(RE_PROTECTED);
+	if (action >= A_TAKE && action <= A_SORT)
+		TRAP_PROTECT(VAL_SERIES(value));
 
 	switch (action) {
 
@@ -1137,7 +1137,7 @@ zero_str:
 
 	case A_SWAP:
 		if (VAL_TYPE(value) != VAL_TYPE(arg)) Trap0(RE_NOT_SAME_TYPE);
-		if (IS_PROTECT_SERIES(VAL_SERIES(arg))) Trap0(RE_PROTECTED);
+		TRAP_PROTECT(VAL_SERIES(arg));
 		if (index < tail && VAL_INDEX(arg) < VAL_TAIL(arg))
 			swap_chars(value, arg);
 		// Trap_Range(arg);  // ignore range error
@@ -1162,7 +1162,7 @@ zero_str:
 		break;
 
 	case A_RANDOM:
-		if(IS_PROTECT_SERIES(VAL_SERIES(value))) Trap0(RE_PROTECTED);
+		TRAP_PROTECT(VAL_SERIES(value));
 		if (D_REF(2)) { // seed
 			Set_Random(Compute_CRC24(VAL_BIN_DATA(value), VAL_LEN(value)));
 			return R_UNSET;
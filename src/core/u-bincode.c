@@ -321,7 +321,7 @@ static REBCNT EncodedVINT_Size(REBU64 value) {
 
 		if(IS_BINARY(val_ctx)) {
 			bin = VAL_SERIES(val_ctx);
-			if (ref_write && IS_PROTECT_SERIES(bin)) Trap0(RE_PROTECTED);
+			if (ref_write) TRAP_PROTECT(bin);
 			SET_BINARY(buffer_write, bin);
 			SET_BINARY(buffer_read, bin);
 			VAL_INDEX(buffer_write) = VAL_INDEX(val_ctx);
@@ -1630,7 +1630,7 @@ static REBCNT EncodedVINT_Size(REBU64 value) {
 							break;
 						case SYM_CROP:
 							n = 0;
-							if (IS_PROTECT_SERIES(bin)) Trap0(RE_PROTECTED);
+							TRAP_PROTECT(bin);
 							Remove_Series(VAL_SERIES(buffer_read), 0, VAL_INDEX(buffer_read));
 							cp = VAL_BIN_HEAD(buffer_read);
 							VAL_INDEX(buffer_write) = MAX(0, (REBI64)VAL_INDEX(buffer_write) - VAL_INDEX(buffer_read));
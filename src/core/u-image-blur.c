@@ -71,9 +71,14 @@ static void boxes_for_gauss(REBDEC sigma, REBINT sizes[3])
 
 static void box_blur_H(REBYTE *scl, REBYTE*tcl, REBINT w, REBINT h, REBINT r, REBINT bpp)
 {
-	REBINT i, j, k, ti, li, ri, fv, lv, val;
+	REBINT i;
+	// Rows are independent, so they may be blurred in parallel.
+#ifdef _OPENMP
+	#pragma omp parallel for schedule(static)
+#endif
 	for (i = 0; i < h; i++)
 	{
+		REBINT j, k, ti, li, ri, fv, lv, val;
 		for (k = 0; k < bpp; k++)
 		{
 			ti  = i * w * bpp + k;
@@ -89,14 +94,14 @@ static void box_blur_H(REBYTE *scl, REBYTE*tcl, REBINT w, REBINT h, REBINT r, RE
 			for (j = 0; j <= r; j++)
 			{
 				val += scl[ri] - fv;
-				tcl[ti] = (REBYTE)round(val / (r + r + 1));
+				tcl[ti] = (REBYTE)(val / (r + r + 1));
 				ri += bpp;
 				ti += bpp;
 			}
 			for (j = r + 1; j < (w - r); j++)
 			{
 				val += scl[ri] - scl[li];
-				tcl[ti] = (REBYTE)round(val / (r + r + 1));
+				tcl[ti] = (REBYTE)(val / (r + r + 1));
 				li += bpp;
 				ri += bpp;
 				ti += bpp;
@@ -104,7 +109,7 @@ static void box_blur_H(REBYTE *scl, REBYTE*tcl, REBINT w, REBINT h, REBINT r, RE
 			for (j = w - r; j < w; j++)
 			{
 				val += lv - scl[li];
-				tcl[ti] = (REBYTE)round(val / (r + r + 1));
+				tcl[ti] = (REBYTE)(val / (r + r + 1));
 				li += bpp;
 				ti += bpp;
 			}
@@ -112,73 +117,86 @@ static void box_blur_H(REBYTE *scl, REBYTE*tcl, REBINT w, REBINT h, REBINT r, RE
 	}
 }
 
-static void box_blur_T(REBYTE*scl, REBYTE*tcl, REBINT w, REBINT h, REBINT r, REBINT bpp)
+// The vertical pass keeps one running sum per byte column (in `acc`)
+// and walks the image row by row, so it reads memory in order.
+// Bands of BLUR_BAND columns are independent.
+static void box_blur_T(REBYTE*scl, REBYTE*tcl, REBINT w, REBINT h, REBINT r, REBINT bpp, REBINT *acc)
 {
-	REBINT i, j, k, ti, li, ri, fv, lv, val;
-	for (i = 0; i < w; i++)
+	REBINT stride = w * bpp;
+	REBINT x0;
+#ifdef _OPENMP
+	#pragma omp parallel for schedule(static)
+#endif
+	for (x0 = 0; x0 < stride; x0 += BLUR_BAND)
 	{
-		for (k = 0; k < bpp; k++)
+		REBINT i, j;
+		REBINT n   = MIN(BLUR_BAND, stride - x0);
+		REBINT *val = acc + x0;
+		REBYTE *fv = scl + x0;
+		REBYTE *lv = scl + (h - 1) * stride + x0;
+		REBYTE *li = fv;
+		REBYTE *ri = fv + r * stride;
+		REBYTE *ti = tcl + x0;
+
+		for (i = 0; i < n; i++)
+			val[i] = (r + 1) * fv[i];
+		for (j = 0; j < r; j++)
 		{
-			ti = i * bpp + k;
-			li = ti;
-			ri = ti + r * w * bpp;
-			fv = scl[ti];
-			lv = scl[ti + w * (h - 1) * bpp];
-			val = (r + 1) * fv;
-			for (j = 0; j < r; j++)
+			for (i = 0; i < n; i++)
+				val[i] += fv[j * stride + i];
+		}
+		for (j = 0; j <= r; j++)
+		{
+			for (i = 0; i < n; i++)
 			{
-				val += scl[ti + j * w * bpp];
+				val[i] += ri[i] - fv[i];
+				ti[i] = (REBYTE)(val[i] / (r + r + 1));
 			}
-			for (j = 0; j <= r; j++)
+			ri += stride;
+			ti += stride;
+		}
+		for (j = r + 1; j < (h - r); j++)
+		{
+			for (i = 0; i < n; i++)
 			{
-				val += scl[ri] - fv;
-				tcl[ti] = (REBYTE)round(val / (r + r + 1));
-				ri += w * bpp;
-				ti += w * bpp;
+				val[i] += ri[i] - li[i];
+				ti[i] = (REBYTE)(val[i] / (r + r + 1));
 			}
-			for (j = r + 1; j < (h - r); j++)
-			{
-				val += scl[ri] - scl[li];
-				tcl[ti] = (REBYTE)round(val / (r + r + 1));
-				li += w * bpp;
-				ri += w * bpp;
-				ti += w * bpp;
-			}
-			for (j = h - r; j < h; j++)
+			li += stride;
+			ri += stride;
+			ti += stride;
+		}
+		for (j = h - r; j < h; j++)
+		{
+			for (i = 0; i < n; i++)
 			{
-				val += lv - scl[li];
-				tcl[ti] = (REBYTE)round(val / (r + r + 1));
-				li += w * bpp;
-				ti += w * bpp;
+				val[i] += lv[i] - li[i];
+				ti[i] = (REBYTE)(val[i] / (r + r + 1));
 			}
+			li += stride;
+			ti += stride;
 		}
 	}
 }
 
-static void box_blur(REBYTE*scl, REBYTE*tcl, REBINT w, REBINT h, REBINT r, REBINT bpp)
+static void box_blur(REBYTE*scl, REBYTE*tcl, REBINT w, REBINT h, REBINT r, REBINT bpp, REBINT *acc)
 {
-	REBINT i;
-	for (i = 0; i < (h * w * bpp); i++)
-	{
-		tcl[i] = scl[i];
-	}
+	COPY_MEM(tcl, scl, h * w * bpp);
 	box_blur_H(tcl, scl, w, h, r, bpp);
-	box_blur_T(scl, tcl, w, h, r, bpp);
+	box_blur_T(scl, tcl, w, h, r, bpp, acc);
 }
 
 void fast_gauss_blur(REBYTE*scl, REBYTE*tcl, REBINT w, REBINT h, REBINT r, REBINT bpp)
 {
-	REBINT i;
 	REBINT bxs[3];
+	REBINT *acc = (REBINT *)Make_Mem(w * bpp * sizeof(REBINT));
 	boxes_for_gauss(r, bxs);
-	box_blur(scl, tcl, w, h, (bxs[0] - 1) / 2, bpp);
-	box_blur(tcl, scl, w, h, (bxs[1] - 1) / 2, bpp);
-	box_blur(scl, tcl, w, h, (bxs[2] - 1) / 2, bpp);
+	box_blur(scl, tcl, w, h, (bxs[0] - 1) / 2, bpp, acc);
+	box_blur(tcl, scl, w, h, (bxs[1] - 1) / 2, bpp, acc);
+	box_blur(scl, tcl, w, h, (bxs[2] - 1) / 2, bpp, acc);
+	Free_Mem(acc, w * bpp * sizeof(REBINT));
 	// result would be in tcl, so copy it back to source, as it is modified anyway
-	for (i = 0; i < (h * w * bpp); i++)
-	{
-		scl[i] = tcl[i];
-	}
+	COPY_MEM(scl, tcl, h * w * bpp);
 }
 
 void BlurImage(REBSER *image, REBCNT radius)
@@ -199,9 +217,11 @@ void BlurImage(REBSER *image, REBCNT radius)
 
 	temp_image = Make_Image(IMG_WIDE(image), IMG_HIGH(image), TRUE);
 
-	// Resize image.
+	// Blur image (in place).
 	
 	fast_gauss_blur(IMG_DATA(image), IMG_DATA(temp_image), IMG_WIDE(image), IMG_HIGH(image), radius, 4);
+
+	Free_Series(temp_image);
 }
 
 #endif // INCLUDE_IMAGE_NATIVES
\ No newline at end of file
@@ -471,20 +471,25 @@ static REBDEC Triangle(const REBDEC x,const REBDEC support)
 	return(0.0);
 }
 
+// Opacity_Scale[a] == (REBDEC)a / OpaqueOpacity (filled by ResizeImage)
+static REBDEC Opacity_Scale[256];
+
+/*
+	The filter contributions are computed for a band of destination
+	columns (or rows) at once, so the pixel loops below only walk
+	precomputed tables and touch the source in memory order.
+	Each destination pixel uses up to `span` contributions.
+*/
 static void
-HorizontalFilter(const REBSER *source, REBSER *destination, REBSER *data_set,
-				 const REBDEC x_factor,const FilterInfo * filter_info,
-				 const REBDEC blur, REBOOL has_alpha)
+Contributions(ContributionInfo *contribution, REBINT *count, const REBINT span,
+			  const REBINT first, const REBINT last, const REBINT source_length,
+			  const REBDEC factor, const FilterInfo * filter_info, const REBDEC blur)
 {
 	REBDEC scale;
 	REBDEC support;
-	REBINT x, y;
-	DoublePixelPacket zero;
-	const PixelPacket *p = (PixelPacket*)IMG_DATA(source);
-	      PixelPacket *q = (PixelPacket*)IMG_DATA(destination);
-	ContributionInfo  *contribution = (ContributionInfo*)SERIES_DATA(data_set);
+	REBINT x;
 
-	scale   = blur  * MAX(1.0 / x_factor, 1.0);
+	scale   = blur  * MAX(1.0 / factor, 1.0);
 	support = scale * filter_info->support;
 
 	if (support <= 0.5)	{
@@ -493,17 +498,16 @@ HorizontalFilter(const REBSER *source, REBSER *destination, REBSER *data_set,
 		scale   = 1.0;
 	}
 	scale = 1.0 / scale;
-	CLEAR(&zero, sizeof(DoublePixelPacket));
 
-	for (x=0; x < (long) IMG_WIDE(destination); x++) {
+	for (x = first; x < last; x++, contribution += span) {
 		REBDEC center;
 		REBDEC density = 0.0;
-		REBINT n, start, stop, i, j;
+		REBINT n, start, stop, i;
 
-		center = (REBDEC) (x+0.5)/x_factor;
+		center = (REBDEC) (x+0.5)/factor;
 		start  = (REBINT) MAX(center-support+0.5,0);
-		stop   = (REBINT) MIN(center+support+0.5,IMG_WIDE(source));
-		
+		stop   = (REBINT) MIN(center+support+0.5,source_length);
+
 		for (n=0; n < (stop-start); n++) {
 			contribution[n].pixel = start+n;
 			contribution[n].weight = filter_info->function(scale*((REBDEC) start+n-center+0.5), filter_info->support);
@@ -516,130 +520,156 @@ HorizontalFilter(const REBSER *source, REBSER *destination, REBSER *data_set,
 			for (i=0; i < n; i++)
 				contribution[i].weight*=density;
 		}
+		*count++ = n;
+	}
+}
 
-		for (y=0; y < (long) IMG_HIGH(destination); y++) {
-			REBDEC weight;
-			DoublePixelPacket pixel = zero;
-
-			if (has_alpha) {
-				REBDEC transparency_coeff;
-				REBDEC normalize = 0.0;
-				
-				for (i=0; i < n; i++) {
-					j = (int)((y * IMG_WIDE(source)) + contribution[i].pixel);
-					weight=contribution[i].weight;
-					transparency_coeff = weight * ((REBDEC) p[j].opacity/OpaqueOpacity);
-					pixel.red     += transparency_coeff * p[j].red;
-					pixel.green   += transparency_coeff * p[j].green;
-					pixel.blue    += transparency_coeff * p[j].blue;
-					pixel.opacity += weight * p[j].opacity;
-					normalize     += transparency_coeff;
-				}
-				normalize    = 1.0 / (ABS(normalize) <= MagickEpsilon ? 1.0 : normalize);
-				pixel.red   *= normalize;
-				pixel.green *= normalize;
-				pixel.blue  *= normalize;
-			}
-			else {
-				for (i=0; i < n; i++) {
-					j = (int)((y * IMG_WIDE(source)) + contribution[i].pixel);
-					weight=contribution[i].weight;
-					pixel.red     += weight * p[j].red;
-					pixel.green   += weight * p[j].green;
-					pixel.blue    += weight * p[j].blue;
-				}
-				pixel.opacity = OpaqueOpacity;
+/*
+	Computes one destination pixel from `n` source pixels found at
+	`p[contribution[i].pixel * stride]`.
+*/
+static void
+FilterPixel(PixelPacket *q, const PixelPacket *p, const REBINT stride,
+			const ContributionInfo *contribution, const REBINT n, REBOOL has_alpha)
+{
+	REBDEC weight;
+	REBDEC transparency_coeff;
+	REBDEC normalize = 0.0;
+	DoublePixelPacket pixel;
+	REBINT i, j;
+
+#ifdef MAGICK_SIMD_SSE2
+	// BGRA bytes are widened to two double pairs: (blue, green) and
+	// (red, opacity). The products and sums are the same as below.
+	__m128i zero = _mm_setzero_si128();
+	__m128d bg = _mm_setzero_pd();
+	__m128d ra = _mm_setzero_pd();
+	__m128i px;
+	__m128d w;
+
+	if (has_alpha) {
+		for (i=0; i < n; i++) {
+			j = contribution[i].pixel * stride;
+			weight = contribution[i].weight;
+			transparency_coeff = weight * Opacity_Scale[p[j].opacity];
+			normalize += transparency_coeff;
+			px = _mm_cvtsi32_si128(*(const int *)&p[j]);
+			px = _mm_unpacklo_epi16(_mm_unpacklo_epi8(px, zero), zero);
+			w  = _mm_set_pd(weight, transparency_coeff);
+			bg = _mm_add_pd(bg, _mm_mul_pd(_mm_unpacklo_pd(w, w), _mm_cvtepi32_pd(px)));
+			ra = _mm_add_pd(ra, _mm_mul_pd(w, _mm_cvtepi32_pd(_mm_srli_si128(px, 8))));
+		}
+	}
+	else {
+		for (i=0; i < n; i++) {
+			j = contribution[i].pixel * stride;
+			px = _mm_cvtsi32_si128(*(const int *)&p[j]);
+			px = _mm_unpacklo_epi16(_mm_unpacklo_epi8(px, zero), zero);
+			w  = _mm_set1_pd(contribution[i].weight);
+			bg = _mm_add_pd(bg, _mm_mul_pd(w, _mm_cvtepi32_pd(px)));
+			ra = _mm_add_pd(ra, _mm_mul_pd(w, _mm_cvtepi32_pd(_mm_srli_si128(px, 8))));
+		}
+	}
+	_mm_storel_pd(&pixel.blue, bg);
+	_mm_storeh_pd(&pixel.green, bg);
+	_mm_storel_pd(&pixel.red, ra);
+	_mm_storeh_pd(&pixel.opacity, ra);
+#else
+	CLEAR(&pixel, sizeof(DoublePixelPacket));
+
+	if (has_alpha) {
+		for (i=0; i < n; i++) {
+			j = contribution[i].pixel * stride;
+			weight = contribution[i].weight;
+			transparency_coeff = weight * Opacity_Scale[p[j].opacity];
+			pixel.red     += transparency_coeff * p[j].red;
+			pixel.green   += transparency_coeff * p[j].green;
+			pixel.blue    += transparency_coeff * p[j].blue;
+			pixel.opacity += weight * p[j].opacity;
+			normalize     += transparency_coeff;
+		}
+	}
+	else {
+		for (i=0; i < n; i++) {
+			j = contribution[i].pixel * stride;
+			weight = contribution[i].weight;
+			pixel.red     += weight * p[j].red;
+			pixel.green   += weight * p[j].green;
+			pixel.blue    += weight * p[j].blue;
+		}
+	}
+#endif
+	if (has_alpha) {
+		normalize    = 1.0 / (ABS(normalize) <= MagickEpsilon ? 1.0 : normalize);
+		pixel.red   *= normalize;
+		pixel.green *= normalize;
+		pixel.blue  *= normalize;
+	}
+	else {
+		pixel.opacity = OpaqueOpacity;
+	}
+	q->red     = RoundDoubleToQuantum(pixel.red);
+	q->green   = RoundDoubleToQuantum(pixel.green);
+	q->blue    = RoundDoubleToQuantum(pixel.blue);
+	q->opacity = RoundDoubleToQuantum(pixel.opacity);
+}
+
+static void
+HorizontalFilter(const REBSER *source, REBSER *destination,
+				 ContributionInfo *contribution, REBINT *count,
+				 const REBINT span, const REBINT band,
+				 const REBDEC x_factor,const FilterInfo * filter_info,
+				 const REBDEC blur, REBOOL has_alpha)
+{
+	const PixelPacket *p = (PixelPacket*)IMG_DATA(source);
+	      PixelPacket *q = (PixelPacket*)IMG_DATA(destination);
+	REBINT wide = IMG_WIDE(destination);
+	REBINT high = IMG_HIGH(destination);
+	REBINT x0, x1, x, y;
+
+	for (x0 = 0; x0 < wide; x0 = x1) {
+		x1 = MIN(x0 + band, wide);
+		Contributions(contribution, count, span, x0, x1, IMG_WIDE(source), x_factor, filter_info, blur);
+
+		// Rows are independent, so they may be filtered in parallel.
+#ifdef _OPENMP
+		#pragma omp parallel for private(x) schedule(static)
+#endif
+		for (y = 0; y < high; y++) {
+			const PixelPacket *row = p + (y * IMG_WIDE(source));
+			for (x = x0; x < x1; x++) {
+				FilterPixel(&q[(y * wide) + x], row, 1,
+					contribution + (x - x0) * span, count[x - x0], has_alpha);
 			}
-			REBINT pix = (y * IMG_WIDE(destination)) + x;
-			q[pix].red     = RoundDoubleToQuantum(pixel.red);
-			q[pix].green   = RoundDoubleToQuantum(pixel.green);
-			q[pix].blue    = RoundDoubleToQuantum(pixel.blue);
-			q[pix].opacity = RoundDoubleToQuantum(pixel.opacity);
 		}
 	}
 }
 
 static void
-VerticalFilter(const REBSER *source, REBSER *destination, REBSER *data_set,
+VerticalFilter(const REBSER *source, REBSER *destination,
+			   ContributionInfo *contribution, REBINT *count,
+			   const REBINT span, const REBINT band,
 			   const REBDEC y_factor,const FilterInfo * filter_info,
 			   const REBDEC blur, REBOOL has_alpha)
 {
-	REBDEC scale;
-	REBDEC support;
-	REBINT x, y;
-	DoublePixelPacket zero;
 	const PixelPacket *p = (PixelPacket*)IMG_DATA(source);
 	      PixelPacket *q = (PixelPacket*)IMG_DATA(destination);
-
-	scale   = blur  * MAX(1.0 / y_factor, 1.0);
-	support = scale * filter_info->support;
-
-	if (support <= 0.5)	{
-		// Reduce to point sampling.
-		support = 0.5 + MagickEpsilon;
-		scale   = 1.0;
-	}
-	scale = 1.0 / scale;
-	CLEAR(&zero, sizeof(DoublePixelPacket));
-
-	for (y=0; y < (long) IMG_HIGH(destination); y++) {
-		REBDEC center;
-		REBDEC density = 0.0;
-		REBINT n, start, stop, i, j;
-		ContributionInfo *contribution = (ContributionInfo*)SERIES_DATA(data_set);
-
-		center = (REBDEC)(y+0.5) / y_factor;
-		start  = (REBINT)MAX(center - support + 0.5, 0);
-		stop   = (REBINT)MIN(center + support + 0.5, IMG_HIGH(source));
-
-		for (n=0; n < (stop-start); n++) {
-			contribution[n].pixel = start+n;
-			contribution[n].weight = filter_info->function(scale*((REBDEC) start+n-center+0.5), filter_info->support);
-			density += contribution[n].weight;
-		}
-		if ((density != 0.0) && (density != 1.0)) {
-			// Normalize.
-			density = 1.0 / density;
-			for (i=0; i < n; i++)
-				contribution[i].weight *= density;
-		}
-		for (x=0; x < (long) IMG_WIDE(destination); x++) {
-			REBDEC weight;
-			DoublePixelPacket pixel = zero;
-
-			if (has_alpha) {
-				REBDEC transparency_coeff;
-				REBDEC normalize = 0.0;
-				for (i=0; i < n; i++) {
-					j = (REBINT)((contribution[i].pixel * IMG_WIDE(source)) + x);
-					weight=contribution[i].weight;
-					transparency_coeff = weight * (((REBDEC) p[j].opacity / OpaqueOpacity));
-					pixel.red    += transparency_coeff * p[j].red;
-					pixel.green  += transparency_coeff * p[j].green;
-					pixel.blue   += transparency_coeff * p[j].blue;
-					pixel.opacity+= weight * p[j].opacity;
-					normalize    += transparency_coeff;
-				}
-				normalize    = 1.0 / (ABS(normalize) <= MagickEpsilon ? 1.0 : normalize);
-				pixel.red   *= normalize;
-				pixel.green *= normalize;
-				pixel.blue  *= normalize;
-			}
-			else {
-				for (i=0; i < n; i++) {
-					j = (REBINT)((contribution[i].pixel * IMG_WIDE(source)) + x);
-					weight       = contribution[i].weight;
-					pixel.red   += weight * p[j].red;
-					pixel.green += weight * p[j].green;
-					pixel.blue  += weight * p[j].blue;
-				}
-				pixel.opacity = OpaqueOpacity;
+	REBINT wide = IMG_WIDE(destination);
+	REBINT high = IMG_HIGH(destination);
+	REBINT y0, y1, x, y;
+
+	for (y0 = 0; y0 < high; y0 = y1) {
+		y1 = MIN(y0 + band, high);
+		Contributions(contribution, count, span, y0, y1, IMG_HIGH(source), y_factor, filter_info, blur);
+
+#ifdef _OPENMP
+		#pragma omp parallel for private(x) schedule(static)
+#endif
+		for (y = y0; y < y1; y++) {
+			for (x = 0; x < wide; x++) {
+				FilterPixel(&q[(y * wide) + x], p + x, IMG_WIDE(source),
+					contribution + (y - y0) * span, count[y - y0], has_alpha);
 			}
-			REBINT pix = (y * IMG_WIDE(destination)) + x;
-			q[pix].red     = RoundDoubleToQuantum(pixel.red);
-			q[pix].green   = RoundDoubleToQuantum(pixel.green);
-			q[pix].blue    = RoundDoubleToQuantum(pixel.blue);
-			q[pix].opacity = RoundDoubleToQuantum(pixel.opacity);
 		}
 	}
 }
@@ -647,7 +677,7 @@ VerticalFilter(const REBSER *source, REBSER *destination, REBSER *data_set,
 
 REBSER *ResizeImage(const REBSER *image,const REBCNT columns,
 					const REBCNT rows,const FilterTypes filter,
-					const REBDEC blur, REBOOL has_alpha)
+					const REBDEC blur, REBOOL has_alpha, REBSER *target)
 {
 	REBDEC support;
 	REBDEC x_factor;
@@ -658,6 +688,10 @@ REBSER *ResizeImage(const REBSER *image,const REBCNT columns,
 	REBSER *resized_image;
 	REBSER *temp_image;
 	REBSER *data_set;
+	REBSER *count_set;
+	ContributionInfo *contribution;
+	REBINT *count;
+	REBINT span, band;
 	register REBINT i;
 	static const FilterInfo
 		filters[SincFilter+1] =
@@ -680,6 +714,11 @@ REBSER *ResizeImage(const REBSER *image,const REBCNT columns,
 			{ BlackmanSinc,   4.0   } 
 		};
 
+	if (Opacity_Scale[OpaqueOpacity] == 0.0) {
+		for (i = 0; i < 256; i++)
+			Opacity_Scale[i] = (REBDEC) i / OpaqueOpacity;
+	}
+
 	// Validate input.
 	if ( image == NULL
 		|| (((int) filter < 0) && ((int) filter > SincFilter))
@@ -691,9 +730,11 @@ REBSER *ResizeImage(const REBSER *image,const REBCNT columns,
 
 	// Prepare output and temporary image.
 
-	resized_image = Make_Image(columns, rows, TRUE);
+	resized_image = target ? target : Make_Image(columns, rows, TRUE);
 
 	if ((columns == IMG_WIDE(image)) && (rows == IMG_HIGH(image)) && (blur == 1.0)) {
+		if (resized_image != image)
+			COPY_MEM(IMG_DATA(resized_image), IMG_DATA(image), columns * rows * 4);
 		return resized_image;
 	}
 
@@ -724,21 +765,28 @@ REBSER *ResizeImage(const REBSER *image,const REBCNT columns,
 	if (support < filters[i].support)
 		support=filters[i].support;
 
-	// Allocate contribution data set.
+	// Allocate contribution data set for a band of columns or rows.
 	
-	data_set = Make_Series((REBCNT)(2.0*MAX(support,0.5)+3), sizeof(ContributionInfo), FALSE);
+	span = (REBINT)(2.0*MAX(support,0.5)+3);
+	band = MAX(1, RESIZE_CONTRIBUTIONS / span);
+	band = MIN(band, (REBINT)MAX(columns, rows));
+	data_set  = Make_Series(span * band, sizeof(ContributionInfo), FALSE);
+	count_set = Make_Series(band, sizeof(REBINT), FALSE);
 	//LABEL_SERIES(series, "ContributionInfo");
 
 	// Resize image.
 	
+	contribution = (ContributionInfo*)SERIES_DATA(data_set);
+	count = (REBINT*)SERIES_DATA(count_set);
 	if (order) {
-		HorizontalFilter(image, temp_image, data_set, x_factor, &filters[i], blur, has_alpha);
-		VerticalFilter(temp_image, resized_image, data_set, y_factor, &filters[i], blur, has_alpha);
+		HorizontalFilter(image, temp_image, contribution, count, span, band, x_factor, &filters[i], blur, has_alpha);
+		VerticalFilter(temp_image, resized_image, contribution, count, span, band, y_factor, &filters[i], blur, has_alpha);
 	} else {
-		VerticalFilter(image, temp_image, data_set, y_factor, &filters[i], blur, has_alpha);
-		HorizontalFilter(temp_image, resized_image, data_set, x_factor, &filters[i], blur, has_alpha);
+		VerticalFilter(image, temp_image, contribution, count, span, band, y_factor, &filters[i], blur, has_alpha);
+		HorizontalFilter(temp_image, resized_image, contribution, count, span, band, x_factor, &filters[i], blur, has_alpha);
 	}
 
+	Free_Series(count_set);
 	Free_Series(data_set);
 	Free_Series(temp_image);
 	return(resized_image);
@@ -234,7 +234,16 @@ jpeg_series_src (j_decompress_ptr cinfo, JOCTET *buffer, size_t nbytes )
   src->pub.next_input_byte = NULL; /* until buffer loaded */
 }
 
-void jpeg_info( char *buffer, int nbytes, int *w, int *h )
+/* The scale argument is the denominator of the DCT-domain downscale
+ * (1, 2, 4 or 8); the image is decoded at ceil(size / scale).
+ */
+static void jpeg_set_scale( j_decompress_ptr cinfo, int scale )
+{
+  cinfo->scale_num = 1;
+  cinfo->scale_denom = (scale == 2 || scale == 4 || scale == 8) ? scale : 1;
+}
+
+void jpeg_info( char *buffer, int nbytes, int scale, int *w, int *h )
 {
   struct jpeg_decompress_struct cinfo;
   struct jpeg_error_mgr jerr;
@@ -248,13 +257,15 @@ void jpeg_info( char *buffer, int nbytes, int *w, int *h )
 
   /* Read file header, set default decompression parameters */
   (void) jpeg_read_header(&cinfo, TRUE);
-  *w = cinfo.image_width;
-  *h = cinfo.image_height;
+  jpeg_set_scale(&cinfo, scale);
+  jpeg_calc_output_dimensions(&cinfo);
+  *w = cinfo.output_width;
+  *h = cinfo.output_height;
 
   jpeg_destroy_decompress(&cinfo);
 }
 
-void jpeg_load( char *buffer, int nbytes, char *output )
+void jpeg_load( char *buffer, int nbytes, int scale, char *output )
 {
   struct jpeg_decompress_struct cinfo;
   struct jpeg_error_mgr jerr;
@@ -270,43 +281,44 @@ void jpeg_load( char *buffer, int nbytes, char *output )
 
   /* Read file header, set default decompression parameters */
   (void) jpeg_read_header(&cinfo, TRUE);
+  jpeg_set_scale(&cinfo, scale);
 
   /* Start decompressor */
   (void) jpeg_start_decompress(&cinfo);
 
   /* Process data */
   while (cinfo.output_scanline < cinfo.output_height) {
-	array[ 0 ] = (JSAMPROW)(output + cinfo.output_scanline * cinfo.image_width * 4);
-	array[ 1 ] = array[ 0 ] + cinfo.image_width * 4;
-	array[ 2 ] = array[ 1 ] + cinfo.image_width * 4;
-	array[ 3 ] = array[ 2 ] + cinfo.image_width * 4;
+	array[ 0 ] = (JSAMPROW)(output + cinfo.output_scanline * cinfo.output_width * 4);
+	array[ 1 ] = array[ 0 ] + cinfo.output_width * 4;
+	array[ 2 ] = array[ 1 ] + cinfo.output_width * 4;
+	array[ 3 ] = array[ 2 ] + cinfo.output_width * 4;
     jpeg_read_scanlines(&cinfo, array, 4 );
   }
 
   if (cinfo.out_color_space != JCS_GRAYSCALE)
   // convert 3 byte values into four byte ones
-  for ( i=0; i<cinfo.image_height; i++ ) {
+  for ( i=0; i<cinfo.output_height; i++ ) {
 	unsigned char	*cp;
 	uinteger32	*dp;
 
-	cp = (unsigned char *)(output + cinfo.image_width * 3);
-	dp = ( uinteger32 * )output + cinfo.image_width;
+	cp = (unsigned char *)(output + cinfo.output_width * 3);
+	dp = ( uinteger32 * )output + cinfo.output_width;
 	output = ( char * )dp;
-	for ( j=0; j<cinfo.image_width; j++ ) {
+	for ( j=0; j<cinfo.output_width; j++ ) {
 		cp -= 3;
 		*--dp = cp[ 2 ] | ( cp[ 1 ] << 8 ) | ( ( uinteger32 )cp[ 0 ] << 16 ) | 0xff000000;
 	}
   }
   else
   // convert 1 byte value into four byte ones
-    for ( i=0; i<cinfo.image_height; i++ ) {
+    for ( i=0; i<cinfo.output_height; i++ ) {
 	  unsigned char *cp;
 	  uinteger32	*dp, c;
 
-	  cp = (unsigned char *)(output + cinfo.image_width);
-	  dp = ( uinteger32 * )output + cinfo.image_width;
+	  cp = (unsigned char *)(output + cinfo.output_width);
+	  dp = ( uinteger32 * )output + cinfo.output_width;
 	  output = ( char * )dp;
-	  for ( j=0; j<cinfo.image_width; j++ ) {
+	  for ( j=0; j<cinfo.output_width; j++ ) {
 		c = *--cp;
 		*--dp = c | (c << 8) | (c << 16);
 	  }
@@ -5596,7 +5608,11 @@ start_pass (j_decompress_ptr cinfo)
       switch (cinfo->dct_method) {
 #ifdef DCT_ISLOW_SUPPORTED
       case JDCT_ISLOW:
+#ifdef JPEG_SIMD_SSE2
+	method_ptr = jpeg_idct_islow_sse2;
+#else
 	method_ptr = jpeg_idct_islow;
+#endif
 	method = JDCT_ISLOW;
 	break;
 #endif
@@ -6748,6 +6764,583 @@ jpeg_idct_islow (j_decompress_ptr cinfo, jpeg_component_info * compptr,
 }
 
 #endif /* DCT_ISLOW_SUPPORTED */
+/*
+ * jidctred.c
+ *
+ * Copyright (C) 1994-1998, Thomas G. Lane.
+ * This file is part of the Independent JPEG Group's software.
+ * For conditions of distribution and use, see the accompanying README file.
+ *
+ * This file contains inverse-DCT routines that produce reduced-size output:
+ * either 4x4, 2x2, or 1x1 pixels from an 8x8 DCT block.
+ *
+ * The implementation is based on the Loeffler, Ligtenberg and Moschytz (LL&M)
+ * algorithm used in jidctint.c.  We simply replace each 8-to-8 1-D IDCT step
+ * with an 8-to-4 step that produces the four averages of two adjacent outputs
+ * (or an 8-to-2 step producing two averages of four outputs, for 2x2 output).
+ * These steps were derived by computing the corresponding values at the end
+ * of the normal LL&M code, then simplifying as much as possible.
+ *
+ * 1x1 is trivial: just take the DC coefficient divided by 8.
+ *
+ * See jidctint.c for additional comments.
+ */
+
+#ifdef IDCT_SCALING_SUPPORTED
+
+
+/*
+ * This module is specialized to the case DCTSIZE = 8.
+ */
+
+#if DCTSIZE != 8
+  Sorry, this code only copes with 8x8 DCTs. /* deliberate syntax err */
+#endif
+
+
+/* Scaling is the same as in jidctint.c. */
+
+#undef CONST_BITS
+#undef PASS1_BITS
+#if BITS_IN_JSAMPLE == 8
+#define CONST_BITS  13
+#define PASS1_BITS  2
+#else
+#define CONST_BITS  13
+#define PASS1_BITS  1		/* lose a little precision to avoid overflow */
+#endif
+
+#undef FIX_0_211164243
+#undef FIX_0_509795579
+#undef FIX_0_601344887
+#undef FIX_0_720959822
+#undef FIX_0_765366865
+#undef FIX_0_850430095
+#undef FIX_0_899976223
+#undef FIX_1_061594337
+#undef FIX_1_272758580
+#undef FIX_1_451774981
+#undef FIX_1_847759065
+#undef FIX_2_172734803
+#undef FIX_2_562915447
+#undef FIX_3_624509785
+#if CONST_BITS == 13
+#define FIX_0_211164243  ((INT32)  1730)	/* FIX(0.211164243) */
+#define FIX_0_509795579  ((INT32)  4176)	/* FIX(0.509795579) */
+#define FIX_0_601344887  ((INT32)  4926)	/* FIX(0.601344887) */
+#define FIX_0_720959822  ((INT32)  5906)	/* FIX(0.720959822) */
+#define FIX_0_765366865  ((INT32)  6270)	/* FIX(0.765366865) */
+#define FIX_0_850430095  ((INT32)  6967)	/* FIX(0.850430095) */
+#define FIX_0_899976223  ((INT32)  7373)	/* FIX(0.899976223) */
+#define FIX_1_061594337  ((INT32)  8697)	/* FIX(1.061594337) */
+#define FIX_1_272758580  ((INT32)  10426)	/* FIX(1.272758580) */
+#define FIX_1_451774981  ((INT32)  11893)	/* FIX(1.451774981) */
+#define FIX_1_847759065  ((INT32)  15137)	/* FIX(1.847759065) */
+#define FIX_2_172734803  ((INT32)  17799)	/* FIX(2.172734803) */
+#define FIX_2_562915447  ((INT32)  20995)	/* FIX(2.562915447) */
+#define FIX_3_624509785  ((INT32)  29692)	/* FIX(3.624509785) */
+#else
+#define FIX_0_211164243  FIX(0.211164243)
+#define FIX_0_509795579  FIX(0.509795579)
+#define FIX_0_601344887  FIX(0.601344887)
+#define FIX_0_720959822  FIX(0.720959822)
+#define FIX_0_765366865  FIX(0.765366865)
+#define FIX_0_850430095  FIX(0.850430095)
+#define FIX_0_899976223  FIX(0.899976223)
+#define FIX_1_061594337  FIX(1.061594337)
+#define FIX_1_272758580  FIX(1.272758580)
+#define FIX_1_451774981  FIX(1.451774981)
+#define FIX_1_847759065  FIX(1.847759065)
+#define FIX_2_172734803  FIX(2.172734803)
+#define FIX_2_562915447  FIX(2.562915447)
+#define FIX_3_624509785  FIX(3.624509785)
+#endif
+
+
+/* Multiply an INT32 variable by an INT32 constant to yield an INT32 result.
+ * For 8-bit samples with the recommended scaling, all the variable
+ * and constant values involved are no more than 16 bits wide, so a
+ * 16x16->32 bit multiply can be used instead of a full 32x32 multiply.
+ * For 12-bit samples, a full 32-bit multiplication will be needed.
+ */
+
+#if BITS_IN_JSAMPLE == 8
+#define jidctr_MULTIPLY(var,const)  MULTIPLY16C16(var,const)
+#else
+#define jidctr_MULTIPLY(var,const)  ((var) * (const))
+#endif
+
+
+/* Dequantize a coefficient by multiplying it by the multiplier-table
+ * entry; produce an int result.  In this module, both inputs and result
+ * are 16 bits or less, so either int or short multiply will work.
+ */
+
+#define jidctr_DEQUANTIZE(coef,quantval)  (((ISLOW_MULT_TYPE) (coef)) * (quantval))
+
+
+/*
+ * Perform dequantization and inverse DCT on one block of coefficients,
+ * producing a reduced-size 4x4 output block.
+ */
+
+GLOBAL(void)
+jpeg_idct_4x4 (j_decompress_ptr cinfo, jpeg_component_info * compptr,
+	       JCOEFPTR coef_block,
+	       JSAMPARRAY output_buf, JDIMENSION output_col)
+{
+  INT32 tmp0, tmp2, tmp10, tmp12;
+  INT32 z1, z2, z3, z4;
+  JCOEFPTR inptr;
+  ISLOW_MULT_TYPE * quantptr;
+  int * wsptr;
+  JSAMPROW outptr;
+  JSAMPLE *range_limit = IDCT_range_limit(cinfo);
+  int ctr;
+  int workspace[DCTSIZE*4];	/* buffers data between passes */
+  SHIFT_TEMPS
+
+  /* Pass 1: process columns from input, store into work array. */
+
+  inptr = coef_block;
+  quantptr = (ISLOW_MULT_TYPE *) compptr->dct_table;
+  wsptr = workspace;
+  for (ctr = DCTSIZE; ctr > 0; inptr++, quantptr++, wsptr++, ctr--) {
+    /* Don't bother to process column 4, because second pass won't use it */
+    if (ctr == DCTSIZE-4)
+      continue;
+    if (inptr[DCTSIZE*1] == 0 && inptr[DCTSIZE*2] == 0 &&
+	inptr[DCTSIZE*3] == 0 && inptr[DCTSIZE*5] == 0 &&
+	inptr[DCTSIZE*6] == 0 && inptr[DCTSIZE*7] == 0) {
+      /* AC terms all zero; we need not examine term 4 for 4x4 output */
+      int dcval = jidctr_DEQUANTIZE(inptr[DCTSIZE*0], quantptr[DCTSIZE*0]) << PASS1_BITS;
+      
+      wsptr[DCTSIZE*0] = dcval;
+      wsptr[DCTSIZE*1] = dcval;
+      wsptr[DCTSIZE*2] = dcval;
+      wsptr[DCTSIZE*3] = dcval;
+      
+      continue;
+    }
+    
+    /* Even part */
+    
+    tmp0 = jidctr_DEQUANTIZE(inptr[DCTSIZE*0], quantptr[DCTSIZE*0]);
+    tmp0 <<= (CONST_BITS+1);
+    
+    z2 = jidctr_DEQUANTIZE(inptr[DCTSIZE*2], quantptr[DCTSIZE*2]);
+    z3 = jidctr_DEQUANTIZE(inptr[DCTSIZE*6], quantptr[DCTSIZE*6]);
+
+    tmp2 = jidctr_MULTIPLY(z2, FIX_1_847759065) + jidctr_MULTIPLY(z3, - FIX_0_765366865);
+    
+    tmp10 = tmp0 + tmp2;
+    tmp12 = tmp0 - tmp2;
+    
+    /* Odd part */
+    
+    z1 = jidctr_DEQUANTIZE(inptr[DCTSIZE*7], quantptr[DCTSIZE*7]);
+    z2 = jidctr_DEQUANTIZE(inptr[DCTSIZE*5], quantptr[DCTSIZE*5]);
+    z3 = jidctr_DEQUANTIZE(inptr[DCTSIZE*3], quantptr[DCTSIZE*3]);
+    z4 = jidctr_DEQUANTIZE(inptr[DCTSIZE*1], quantptr[DCTSIZE*1]);
+    
+    tmp0 = jidctr_MULTIPLY(z1, - FIX_0_211164243) /* sqrt(2) * (c3-c1) */
+	 + jidctr_MULTIPLY(z2, FIX_1_451774981) /* sqrt(2) * (c3+c7) */
+	 + jidctr_MULTIPLY(z3, - FIX_2_172734803) /* sqrt(2) * (-c1-c5) */
+	 + jidctr_MULTIPLY(z4, FIX_1_061594337); /* sqrt(2) * (c5+c7) */
+    
+    tmp2 = jidctr_MULTIPLY(z1, - FIX_0_509795579) /* sqrt(2) * (c7-c5) */
+	 + jidctr_MULTIPLY(z2, - FIX_0_601344887) /* sqrt(2) * (c5-c1) */
+	 + jidctr_MULTIPLY(z3, FIX_0_899976223) /* sqrt(2) * (c3-c7) */
+	 + jidctr_MULTIPLY(z4, FIX_2_562915447); /* sqrt(2) * (c1+c3) */
+
+    /* Final output stage */
+    
+    wsptr[DCTSIZE*0] = (int) DESCALE(tmp10 + tmp2, CONST_BITS-PASS1_BITS+1);
+    wsptr[DCTSIZE*3] = (int) DESCALE(tmp10 - tmp2, CONST_BITS-PASS1_BITS+1);
+    wsptr[DCTSIZE*1] = (int) DESCALE(tmp12 + tmp0, CONST_BITS-PASS1_BITS+1);
+    wsptr[DCTSIZE*2] = (int) DESCALE(tmp12 - tmp0, CONST_BITS-PASS1_BITS+1);
+  }
+  
+  /* Pass 2: process 4 rows from work array, store into output array. */
+
+  wsptr = workspace;
+  for (ctr = 0; ctr < 4; ctr++) {
+    outptr = output_buf[ctr] + output_col;
+    /* It's not clear whether a zero row test is worthwhile here ... */
+
+#ifndef NO_ZERO_ROW_TEST
+    if (wsptr[1] == 0 && wsptr[2] == 0 && wsptr[3] == 0 &&
+	wsptr[5] == 0 && wsptr[6] == 0 && wsptr[7] == 0) {
+      /* AC terms all zero */
+      JSAMPLE dcval = range_limit[(int) DESCALE((INT32) wsptr[0], PASS1_BITS+3)
+				  & RANGE_MASK];
+      
+      outptr[0] = dcval;
+      outptr[1] = dcval;
+      outptr[2] = dcval;
+      outptr[3] = dcval;
+      
+      wsptr += DCTSIZE;		/* advance pointer to next row */
+      continue;
+    }
+#endif
+    
+    /* Even part */
+    
+    tmp0 = ((INT32) wsptr[0]) << (CONST_BITS+1);
+    
+    tmp2 = jidctr_MULTIPLY((INT32) wsptr[2], FIX_1_847759065)
+	 + jidctr_MULTIPLY((INT32) wsptr[6], - FIX_0_765366865);
+    
+    tmp10 = tmp0 + tmp2;
+    tmp12 = tmp0 - tmp2;
+    
+    /* Odd part */
+    
+    z1 = (INT32) wsptr[7];
+    z2 = (INT32) wsptr[5];
+    z3 = (INT32) wsptr[3];
+    z4 = (INT32) wsptr[1];
+    
+    tmp0 = jidctr_MULTIPLY(z1, - FIX_0_211164243) /* sqrt(2) * (c3-c1) */
+	 + jidctr_MULTIPLY(z2, FIX_1_451774981) /* sqrt(2) * (c3+c7) */
+	 + jidctr_MULTIPLY(z3, - FIX_2_172734803) /* sqrt(2) * (-c1-c5) */
+	 + jidctr_MULTIPLY(z4, FIX_1_061594337); /* sqrt(2) * (c5+c7) */
+    
+    tmp2 = jidctr_MULTIPLY(z1, - FIX_0_509795579) /* sqrt(2) * (c7-c5) */
+	 + jidctr_MULTIPLY(z2, - FIX_0_601344887) /* sqrt(2) * (c5-c1) */
+	 + jidctr_MULTIPLY(z3, FIX_0_899976223) /* sqrt(2) * (c3-c7) */
+	 + jidctr_MULTIPLY(z4, FIX_2_562915447); /* sqrt(2) * (c1+c3) */
+
+    /* Final output stage */
+    
+    outptr[0] = range_limit[(int) DESCALE(tmp10 + tmp2,
+					  CONST_BITS+PASS1_BITS+3+1)
+			    & RANGE_MASK];
+    outptr[3] = range_limit[(int) DESCALE(tmp10 - tmp2,
+					  CONST_BITS+PASS1_BITS+3+1)
+			    & RANGE_MASK];
+    outptr[1] = range_limit[(int) DESCALE(tmp12 + tmp0,
+					  CONST_BITS+PASS1_BITS+3+1)
+			    & RANGE_MASK];
+    outptr[2] = range_limit[(int) DESCALE(tmp12 - tmp0,
+					  CONST_BITS+PASS1_BITS+3+1)
+			    & RANGE_MASK];
+    
+    wsptr += DCTSIZE;		/* advance pointer to next row */
+  }
+}
+
+
+/*
+ * Perform dequantization and inverse DCT on one block of coefficients,
+ * producing a reduced-size 2x2 output block.
+ */
+
+GLOBAL(void)
+jpeg_idct_2x2 (j_decompress_ptr cinfo, jpeg_component_info * compptr,
+	       JCOEFPTR coef_block,
+	       JSAMPARRAY output_buf, JDIMENSION output_col)
+{
+  INT32 tmp0, tmp10, z1;
+  JCOEFPTR inptr;
+  ISLOW_MULT_TYPE * quantptr;
+  int * wsptr;
+  JSAMPROW outptr;
+  JSAMPLE *range_limit = IDCT_range_limit(cinfo);
+  int ctr;
+  int workspace[DCTSIZE*2];	/* buffers data between passes */
+  SHIFT_TEMPS
+
+  /* Pass 1: process columns from input, store into work array. */
+
+  inptr = coef_block;
+  quantptr = (ISLOW_MULT_TYPE *) compptr->dct_table;
+  wsptr = workspace;
+  for (ctr = DCTSIZE; ctr > 0; inptr++, quantptr++, wsptr++, ctr--) {
+    /* Don't bother to process columns 2,4,6 */
+    if (ctr == DCTSIZE-2 || ctr == DCTSIZE-4 || ctr == DCTSIZE-6)
+      continue;
+    if (inptr[DCTSIZE*1] == 0 && inptr[DCTSIZE*3] == 0 &&
+	inptr[DCTSIZE*5] == 0 && inptr[DCTSIZE*7] == 0) {
+      /* AC terms all zero; we need not examine terms 2,4,6 for 2x2 output */
+      int dcval = jidctr_DEQUANTIZE(inptr[DCTSIZE*0], quantptr[DCTSIZE*0]) << PASS1_BITS;
+      
+      wsptr[DCTSIZE*0] = dcval;
+      wsptr[DCTSIZE*1] = dcval;
+      
+      continue;
+    }
+    
+    /* Even part */
+    
+    z1 = jidctr_DEQUANTIZE(inptr[DCTSIZE*0], quantptr[DCTSIZE*0]);
+    tmp10 = z1 << (CONST_BITS+2);
+    
+    /* Odd part */
+
+    z1 = jidctr_DEQUANTIZE(inptr[DCTSIZE*7], quantptr[DCTSIZE*7]);
+    tmp0 = jidctr_MULTIPLY(z1, - FIX_0_720959822); /* sqrt(2) * (c7-c5+c3-c1) */
+    z1 = jidctr_DEQUANTIZE(inptr[DCTSIZE*5], quantptr[DCTSIZE*5]);
+    tmp0 += jidctr_MULTIPLY(z1, FIX_0_850430095); /* sqrt(2) * (-c1+c3+c5+c7) */
+    z1 = jidctr_DEQUANTIZE(inptr[DCTSIZE*3], quantptr[DCTSIZE*3]);
+    tmp0 += jidctr_MULTIPLY(z1, - FIX_1_272758580); /* sqrt(2) * (-c1+c3-c5-c7) */
+    z1 = jidctr_DEQUANTIZE(inptr[DCTSIZE*1], quantptr[DCTSIZE*1]);
+    tmp0 += jidctr_MULTIPLY(z1, FIX_3_624509785); /* sqrt(2) * (c1+c3+c5+c7) */
+
+    /* Final output stage */
+    
+    wsptr[DCTSIZE*0] = (int) DESCALE(tmp10 + tmp0, CONST_BITS-PASS1_BITS+2);
+    wsptr[DCTSIZE*1] = (int) DESCALE(tmp10 - tmp0, CONST_BITS-PASS1_BITS+2);
+  }
+  
+  /* Pass 2: process 2 rows from work array, store into output array. */
+
+  wsptr = workspace;
+  for (ctr = 0; ctr < 2; ctr++) {
+    outptr = output_buf[ctr] + output_col;
+    /* It's not clear whether a zero row test is worthwhile here ... */
+
+#ifndef NO_ZERO_ROW_TEST
+    if (wsptr[1] == 0 && wsptr[3] == 0 && wsptr[5] == 0 && wsptr[7] == 0) {
+      /* AC terms all zero */
+      JSAMPLE dcval = range_limit[(int) DESCALE((INT32) wsptr[0], PASS1_BITS+3)
+				  & RANGE_MASK];
+      
+      outptr[0] = dcval;
+      outptr[1] = dcval;
+      
+      wsptr += DCTSIZE;		/* advance pointer to next row */
+      continue;
+    }
+#endif
+    
+    /* Even part */
+    
+    tmp10 = ((INT32) wsptr[0]) << (CONST_BITS+2);
+    
+    /* Odd part */
+
+    tmp0 = jidctr_MULTIPLY((INT32) wsptr[7], - FIX_0_720959822) /* sqrt(2) * (c7-c5+c3-c1) */
+	 + jidctr_MULTIPLY((INT32) wsptr[5], FIX_0_850430095) /* sqrt(2) * (-c1+c3+c5+c7) */
+	 + jidctr_MULTIPLY((INT32) wsptr[3], - FIX_1_272758580) /* sqrt(2) * (-c1+c3-c5-c7) */
+	 + jidctr_MULTIPLY((INT32) wsptr[1], FIX_3_624509785); /* sqrt(2) * (c1+c3+c5+c7) */
+
+    /* Final output stage */
+    
+    outptr[0] = range_limit[(int) DESCALE(tmp10 + tmp0,
+					  CONST_BITS+PASS1_BITS+3+2)
+			    & RANGE_MASK];
+    outptr[1] = range_limit[(int) DESCALE(tmp10 - tmp0,
+					  CONST_BITS+PASS1_BITS+3+2)
+			    & RANGE_MASK];
+    
+    wsptr += DCTSIZE;		/* advance pointer to next row */
+  }
+}
+
+
+/*
+ * Perform dequantization and inverse DCT on one block of coefficients,
+ * producing a reduced-size 1x1 output block.
+ */
+
+GLOBAL(void)
+jpeg_idct_1x1 (j_decompress_ptr cinfo, jpeg_component_info * compptr,
+	       JCOEFPTR coef_block,
+	       JSAMPARRAY output_buf, JDIMENSION output_col)
+{
+  int dcval;
+  ISLOW_MULT_TYPE * quantptr;
+  JSAMPLE *range_limit = IDCT_range_limit(cinfo);
+  SHIFT_TEMPS
+
+  /* We hardly need an inverse DCT routine for this: just take the
+   * average pixel value, which is one-eighth of the DC coefficient.
+   */
+  quantptr = (ISLOW_MULT_TYPE *) compptr->dct_table;
+  dcval = jidctr_DEQUANTIZE(coef_block[0], quantptr[0]);
+  dcval = (int) DESCALE((INT32) dcval, 3);
+
+  output_buf[0][output_col] = range_limit[dcval & RANGE_MASK];
+}
+
+#endif /* IDCT_SCALING_SUPPORTED */
+/*
+ * jidctint-sse2
+ *
+ * SSE2 version of jpeg_idct_islow (see jidctint.c above). Each 1-D pass
+ * works on eight columns (or rows) at once in 16-bit lanes, with products
+ * and sums done in 32 bits by _mm_madd_epi16, so the results are the same
+ * as from the C version for any valid input. Between the passes the block
+ * is transposed.
+ */
+
+#if defined(JPEG_SIMD_SSE2) && defined(DCT_ISLOW_SUPPORTED)
+
+#include <emmintrin.h>
+
+#undef CONST_BITS
+#undef PASS1_BITS
+#define CONST_BITS  13
+#define PASS1_BITS  2
+
+/* Constant vector for _mm_madd_epi16 of interleaved (a, b) pairs: a*x + b*y */
+#define jsimd_PAIR(x,y)  _mm_set_epi16((short)(y),(short)(x),(short)(y),(short)(x), \
+                                       (short)(y),(short)(x),(short)(y),(short)(x))
+
+/* Transpose 8x8 block of 16-bit values held in 8 vectors. */
+LOCAL(void)
+jsimd_transpose_8x8 (__m128i *v)
+{
+  __m128i a0 = _mm_unpacklo_epi16(v[0], v[1]);
+  __m128i a1 = _mm_unpackhi_epi16(v[0], v[1]);
+  __m128i a2 = _mm_unpacklo_epi16(v[2], v[3]);
+  __m128i a3 = _mm_unpackhi_epi16(v[2], v[3]);
+  __m128i a4 = _mm_unpacklo_epi16(v[4], v[5]);
+  __m128i a5 = _mm_unpackhi_epi16(v[4], v[5]);
+  __m128i a6 = _mm_unpacklo_epi16(v[6], v[7]);
+  __m128i a7 = _mm_unpackhi_epi16(v[6], v[7]);
+  __m128i b0 = _mm_unpacklo_epi32(a0, a2);
+  __m128i b1 = _mm_unpackhi_epi32(a0, a2);
+  __m128i b2 = _mm_unpacklo_epi32(a1, a3);
+  __m128i b3 = _mm_unpackhi_epi32(a1, a3);
+  __m128i b4 = _mm_unpacklo_epi32(a4, a6);
+  __m128i b5 = _mm_unpackhi_epi32(a4, a6);
+  __m128i b6 = _mm_unpacklo_epi32(a5, a7);
+  __m128i b7 = _mm_unpackhi_epi32(a5, a7);
+  v[0] = _mm_unpacklo_epi64(b0, b4);
+  v[1] = _mm_unpackhi_epi64(b0, b4);
+  v[2] = _mm_unpacklo_epi64(b1, b5);
+  v[3] = _mm_unpackhi_epi64(b1, b5);
+  v[4] = _mm_unpacklo_epi64(b2, b6);
+  v[5] = _mm_unpackhi_epi64(b2, b6);
+  v[6] = _mm_unpacklo_epi64(b3, b7);
+  v[7] = _mm_unpackhi_epi64(b3, b7);
+}
+
+/* One 1-D LL&M IDCT step on 4 lanes; the inputs are interleaved pairs
+ * (in0,in4) (in2,in6) (in7,in1) (in5,in3) (in7,in3) (in5,in1).
+ * Outputs are descaled by shift and left as 32-bit values.
+ */
+LOCAL(void)
+jsimd_idct_half (__m128i p04, __m128i p26, __m128i p71, __m128i p53,
+		 __m128i p73, __m128i p51, __m128i round, __m128i shift,
+		 __m128i *out)
+{
+  const __m128i k_tmp0 = jsimd_PAIR(1 << CONST_BITS, 1 << CONST_BITS);
+  const __m128i k_tmp1 = jsimd_PAIR(1 << CONST_BITS, -(1 << CONST_BITS));
+  const __m128i k_tmp2 = jsimd_PAIR(FIX_0_541196100, FIX_0_541196100 - FIX_1_847759065);
+  const __m128i k_tmp3 = jsimd_PAIR(FIX_0_541196100 + FIX_0_765366865, FIX_0_541196100);
+  const __m128i k_odd0 = jsimd_PAIR(FIX_0_298631336 - FIX_0_899976223, - FIX_0_899976223);
+  const __m128i k_odd3 = jsimd_PAIR(- FIX_0_899976223, FIX_1_501321110 - FIX_0_899976223);
+  const __m128i k_odd1 = jsimd_PAIR(FIX_2_053119869 - FIX_2_562915447, - FIX_2_562915447);
+  const __m128i k_odd2 = jsimd_PAIR(- FIX_2_562915447, FIX_3_072711026 - FIX_2_562915447);
+  const __m128i k_z3a  = jsimd_PAIR(FIX_1_175875602 - FIX_1_961570560, FIX_1_175875602 - FIX_1_961570560);
+  const __m128i k_z3b  = jsimd_PAIR(FIX_1_175875602, FIX_1_175875602);
+  const __m128i k_z4b  = jsimd_PAIR(FIX_1_175875602 - FIX_0_390180644, FIX_1_175875602 - FIX_0_390180644);
+  __m128i tmp0, tmp1, tmp2, tmp3, tmp10, tmp11, tmp12, tmp13, z3, z4, o0, o1, o2, o3;
+
+  /* Even part */
+  tmp0 = _mm_madd_epi16(p04, k_tmp0);
+  tmp1 = _mm_madd_epi16(p04, k_tmp1);
+  tmp2 = _mm_madd_epi16(p26, k_tmp2);
+  tmp3 = _mm_madd_epi16(p26, k_tmp3);
+  tmp10 = _mm_add_epi32(tmp0, tmp3);
+  tmp13 = _mm_sub_epi32(tmp0, tmp3);
+  tmp11 = _mm_add_epi32(tmp1, tmp2);
+  tmp12 = _mm_sub_epi32(tmp1, tmp2);
+
+  /* Odd part; z5 is folded into z3 and z4 */
+  z3 = _mm_add_epi32(_mm_madd_epi16(p73, k_z3a), _mm_madd_epi16(p51, k_z3b));
+  z4 = _mm_add_epi32(_mm_madd_epi16(p73, k_z3b), _mm_madd_epi16(p51, k_z4b));
+  o0 = _mm_add_epi32(_mm_madd_epi16(p71, k_odd0), z3);
+  o3 = _mm_add_epi32(_mm_madd_epi16(p71, k_odd3), z4);
+  o1 = _mm_add_epi32(_mm_madd_epi16(p53, k_odd1), z4);
+  o2 = _mm_add_epi32(_mm_madd_epi16(p53, k_odd2), z3);
+
+  /* Final output stage */
+  out[0] = _mm_sra_epi32(_mm_add_epi32(_mm_add_epi32(tmp10, o3), round), shift);
+  out[7] = _mm_sra_epi32(_mm_add_epi32(_mm_sub_epi32(tmp10, o3), round), shift);
+  out[1] = _mm_sra_epi32(_mm_add_epi32(_mm_add_epi32(tmp11, o2), round), shift);
+  out[6] = _mm_sra_epi32(_mm_add_epi32(_mm_sub_epi32(tmp11, o2), round), shift);
+  out[2] = _mm_sra_epi32(_mm_add_epi32(_mm_add_epi32(tmp12, o1), round), shift);
+  out[5] = _mm_sra_epi32(_mm_add_epi32(_mm_sub_epi32(tmp12, o1), round), shift);
+  out[3] = _mm_sra_epi32(_mm_add_epi32(_mm_add_epi32(tmp13, o0), round), shift);
+  out[4] = _mm_sra_epi32(_mm_add_epi32(_mm_sub_epi32(tmp13, o0), round), shift);
+}
+
+/* 1-D IDCT of eight 16-bit vectors in place, descaled by shift bits. */
+LOCAL(void)
+jsimd_idct_1d (__m128i *v, int shift)
+{
+  __m128i lo[8], hi[8];
+  __m128i round = _mm_set1_epi32(ONE << (shift-1));
+  __m128i cnt = _mm_cvtsi32_si128(shift);
+  int i;
+
+  jsimd_idct_half(_mm_unpacklo_epi16(v[0], v[4]), _mm_unpacklo_epi16(v[2], v[6]),
+		  _mm_unpacklo_epi16(v[7], v[1]), _mm_unpacklo_epi16(v[5], v[3]),
+		  _mm_unpacklo_epi16(v[7], v[3]), _mm_unpacklo_epi16(v[5], v[1]),
+		  round, cnt, lo);
+  jsimd_idct_half(_mm_unpackhi_epi16(v[0], v[4]), _mm_unpackhi_epi16(v[2], v[6]),
+		  _mm_unpackhi_epi16(v[7], v[1]), _mm_unpackhi_epi16(v[5], v[3]),
+		  _mm_unpackhi_epi16(v[7], v[3]), _mm_unpackhi_epi16(v[5], v[1]),
+		  round, cnt, hi);
+  for (i = 0; i < 8; i++)
+    v[i] = _mm_packs_epi32(lo[i], hi[i]);
+}
+
+GLOBAL(void)
+jpeg_idct_islow_sse2 (j_decompress_ptr cinfo, jpeg_component_info * compptr,
+		      JCOEFPTR coef_block,
+		      JSAMPARRAY output_buf, JDIMENSION output_col)
+{
+  ISLOW_MULT_TYPE * quantptr = (ISLOW_MULT_TYPE *) compptr->dct_table;
+  __m128i v[8], ac;
+  int ctr;
+
+  /* Dequantize rows of coefficients (lanes are the columns) */
+  for (ctr = 0; ctr < DCTSIZE; ctr++) {
+    __m128i q = _mm_packs_epi32(
+      _mm_loadu_si128((const __m128i *) (quantptr + ctr*DCTSIZE)),
+      _mm_loadu_si128((const __m128i *) (quantptr + ctr*DCTSIZE + 4)));
+    v[ctr] = _mm_mullo_epi16(_mm_loadu_si128((const __m128i *) (coef_block + ctr*DCTSIZE)), q);
+  }
+
+  /* Blocks with only the DC term are common; every output is the same */
+  ac = _mm_or_si128(_mm_insert_epi16(v[0], 0, 0), v[1]);
+  for (ctr = 2; ctr < DCTSIZE; ctr++)
+    ac = _mm_or_si128(ac, v[ctr]);
+  if (_mm_movemask_epi8(_mm_cmpeq_epi8(ac, _mm_setzero_si128())) == 0xFFFF) {
+    JSAMPLE *range_limit = IDCT_range_limit(cinfo);
+    SHIFT_TEMPS
+    INT32 dc = ((INT32) (short) _mm_cvtsi128_si32(v[0])) << PASS1_BITS;
+    JSAMPLE dcval = range_limit[(int) DESCALE(dc, PASS1_BITS+3) & RANGE_MASK];
+    for (ctr = 0; ctr < DCTSIZE; ctr++)
+      memset((void *) (output_buf[ctr] + output_col), dcval, DCTSIZE);
+    return;
+  }
+
+  /* Pass 1: columns; results are scaled up by PASS1_BITS */
+  jsimd_idct_1d(v, CONST_BITS-PASS1_BITS);
+  jsimd_transpose_8x8(v);
+
+  /* Pass 2: rows; descale by 8 and undo PASS1_BITS */
+  jsimd_idct_1d(v, CONST_BITS+PASS1_BITS+3);
+  jsimd_transpose_8x8(v);
+
+  /* Range limit like IDCT_range_limit: center and saturate to 0..255 */
+  for (ctr = 0; ctr < DCTSIZE; ctr += 2) {
+    __m128i center = _mm_set1_epi16(CENTERJSAMPLE);
+    __m128i rows = _mm_packus_epi16(_mm_adds_epi16(v[ctr], center),
+				    _mm_adds_epi16(v[ctr+1], center));
+    _mm_storel_epi64((__m128i *) (output_buf[ctr] + output_col), rows);
+    _mm_storel_epi64((__m128i *) (output_buf[ctr+1] + output_col), _mm_srli_si128(rows, 8));
+  }
+}
+
+#endif /* JPEG_SIMD_SSE2 */
 /*
  * jdsample.c
  *
@@ -10830,16 +11423,18 @@ extern void Register_Codec(const char *name, codo dispatcher);
 		if (codi->len < 125) { // mininamal JPEG size: https://stackoverflow.com/a/2349470/494472
 			codi->error = CODI_ERR_BAD_DATA; 
 		} else {
-			jpeg_info(s_cast(codi->data), codi->len, &w, &h); // will throw errors
+			jpeg_info(s_cast(codi->data), codi->len, 1, &w, &h); // will throw errors
 		}
 		return CODI_CHECK;
 	}
 
 	if (codi->action == CODI_DECODE) {
 		int w, h;
-		jpeg_info(s_cast(codi->data), codi->len, &w, &h);
+		// optional level is the downscale denominator (1, 2, 4 or 8)
+		int scale = codi->level > 0 ? codi->level : 1;
+		jpeg_info(s_cast(codi->data), codi->len, scale, &w, &h);
 		codi->bits = (u32 *)Make_Mem(w * h * 4);
-		jpeg_load(s_cast(codi->data), codi->len, (char *)codi->bits);
+		jpeg_load(s_cast(codi->data), codi->len, scale, (char *)codi->bits);
 		codi->w = w;
 		codi->h = h;
 		return CODI_IMAGE;
@@ -1408,7 +1408,7 @@ post:
 				if (GET_FLAG(flags, PF_REMOVE)) {
 do_remove:
 					if (count) {
-						if (IS_PROTECT_SERIES(series)) Trap0(RE_PROTECTED);
+						TRAP_PROTECT(series);
 						Remove_Series(series, begin, count);
 					}
 					SET_FLAG(parse->flags, PF_ADVANCE);
@@ -1433,7 +1433,7 @@ do_remove:
 					}
 					if (IS_UNSET(item)) Trap1(RE_NO_VALUE, rules-1);
 					if (IS_END(item)) goto bad_end;
-					if (IS_PROTECT_SERIES(series)) Trap0(RE_PROTECTED);
+					TRAP_PROTECT(series);
 					if (IS_BLOCK_INPUT(parse)) {
 						index = Modify_Block(GET_FLAG(flags, PF_CHANGE) ? A_CHANGE : A_INSERT,
 								series, begin, item, cmd, count, 1);
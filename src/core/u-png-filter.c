@@ -73,6 +73,46 @@ static REBYTE get_png_filter_type(REBVAL* val) {
 	Trap1(RE_INVALID_ARG, val);
 }
 
+/***********************************************************************
+**
+*/	void Filter_PNG_Row(REBYTE *out, const REBYTE *scan, const REBYTE *prev, REBCNT width, REBCNT bpp, REBINT filter)
+/*
+**		Apply one PNG filter type to a scanline of width bytes.
+**		The prev scanline must be zeroed for the first row.
+**		Any other type (0) just copies the scanline.
+**
+***********************************************************************/
+{
+	REBCNT c;
+
+	switch (filter) {
+	case PNG_FILTER_SUB:
+		for (c = 0; c < bpp; c++)
+			out[c] = scan[c];
+		for (c = bpp; c < width; c++)
+			out[c] = scan[c] - scan[c - bpp];
+		break;
+	case PNG_FILTER_UP:
+		for (c = 0; c < width; c++)
+			out[c] = scan[c] - prev[c];
+		break;
+	case PNG_FILTER_AVERAGE:
+		for (c = 0; c < bpp; c++)
+			out[c] = scan[c] - (prev[c] >> 1);
+		for (c = bpp; c < width; c++)
+			out[c] = scan[c] - ((scan[c - bpp] + prev[c]) >> 1) & 0xFF;
+		break;
+	case PNG_FILTER_PAETH:
+		for (c = 0; c < bpp; c++)
+			out[c] = scan[c] - prev[c];
+		for (c = bpp; c < width; c++)
+			out[c] = scan[c] - paeth_predictor(scan[c - bpp], prev[c], prev[c - bpp]);
+		break;
+	default:
+		memcpy(out, scan, width);
+	}
+}
+
 /***********************************************************************
 **
 */	REBNATIVE(filter)
@@ -95,7 +135,7 @@ static REBYTE get_png_filter_type(REBVAL* val) {
 	REBSER *ser;
 	REBYTE *bin = VAL_BIN_DATA(val_data);
 	REBYTE *scan, *prev, *temp, *out;
-	REBCNT r, c, rows, bytes;
+	REBCNT r, rows, bytes;
 	REBCNT width = (REBCNT)AS_INT32(val_width);
 	REBYTE filter = get_png_filter_type(val_type);
 	REBCNT bpp = ref_skip ? VAL_INT32(val_bpp) : 1;
@@ -122,31 +162,7 @@ static REBYTE get_png_filter_type(REBVAL* val) {
 	for (r = 0; r < rows; r++) {
 		scan = bin + (r * width);
 		out  = BIN_SKIP(ser, r * width);
-
-		switch (filter) {
-		case PNG_FILTER_SUB:
-			for (c = 0; c < bpp; c++)
-				out[c] = scan[c];
-			for (c = bpp; c < width; c++)
-				out[c] = scan[c] - scan[c - bpp];
-			break;
-		case PNG_FILTER_UP:
-			for (c = 0; c < width; c++)
-				out[c] = scan[c] - prev[c];
-			break;
-		case PNG_FILTER_AVERAGE:
-			for (c = 0; c < bpp; c++)
-				out[c] = scan[c] - (prev[c] >> 1);
-			for (c = bpp; c < width; c++)
-				out[c] = scan[c] - ((scan[c - bpp] + prev[c]) >> 1) & 0xFF;
-			break;
-		case PNG_FILTER_PAETH:
-			for (c = 0; c < bpp; c++)
-				out[c] = scan[c] - prev[c];
-			for (c = bpp; c < width; c++)
-				out[c] = scan[c] - paeth_predictor(scan[c - bpp], prev[c], prev[c - bpp]);
-			break;
-		}
+		Filter_PNG_Row(out, scan, prev, width, bpp, filter);
 		prev = scan;
 	}
 	Free_Managed_Mem(0, temp);
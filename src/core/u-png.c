@@ -688,27 +688,75 @@ static void emitchunk(unsigned char **cpp,char *type,char *data,int length) {
 	*cpp=cp;
 }
 
+#ifdef INCLUDE_PNG_FILTER
+/***********************************************************************
+**
+*/	static void filter_row(unsigned char *out, unsigned char *scan, unsigned char *prev, unsigned char *temp, int width, int bpp)
+/*
+**		Choose the filter type of a scanline adaptively: try all five
+**		and keep the one with the minimum sum of absolute differences
+**		(as signed bytes), which is the heuristic libpng uses.
+**		Output is the type byte followed by the filtered scanline.
+**
+***********************************************************************/
+{
+	int type, best_type = 0, c;
+	unsigned int sum, best_sum = 0xFFFFFFFF;
+	unsigned char *cand;
+
+	for (type = 0; type <= 4; type++) {
+		cand = (type == 0) ? scan : temp;
+		if (type > 0) Filter_PNG_Row(cand, scan, prev, width, bpp, type);
+		sum = 0;
+		for (c = 0; c < width && sum < best_sum; c++)
+			sum += int_abs((signed char)cand[c]);
+		if (sum < best_sum) {
+			best_sum = sum;
+			best_type = type;
+			if (type > 0) memcpy(out + 1, cand, width);
+		}
+	}
+	if (best_type == 0) memcpy(out + 1, scan, width);
+	out[0] = (unsigned char)best_type;
+}
+#endif
+
 /***********************************************************************
 **
 */	void Encode_PNG_Image(REBCDI *codi)
 /*
 **		Input:  Image bits (codi->bits, w, h)
+**		        Compression level (codi->level, -1 for default)
 **		Output: PNG encoded image (codi->data, len)
 **		Error:  Code in codi->error
 **
+**		Each scanline gets an adaptively chosen filter and the whole
+**		filtered image is compressed at once (using libdeflate if
+**		available, which is much faster than zlib).
+**
 ***********************************************************************/
 {
 	REBINT w = codi->w;
 	REBINT h = codi->h;
 	struct ihdrchunk ihdr;
 	struct idatnode *firstidat,*currentidat;
-	unsigned char *linebuf,*cp;
-	int x,y,imgsize,ret;
-	z_stream zstream={0};
+	unsigned char *filtered,*rowbuf,*cp;
+	int x,y,imgsize,bpp,rowbytes;
 	REBCNT *dp,cv;
 	REBOOL hasalpha;
+	REBINT level = codi->level;
+#ifdef INCLUDE_DEFLATE
+	REBSER *zipped = NULL;
+	REBINT zerr = 0;
+	REBCNT zpos, zlen;
+#else
+	int ret;
+	z_stream zstream={0};
+#endif
 
 	hasalpha = codi->alpha;
+	bpp = hasalpha ? 4 : 3;
+	rowbytes = bpp * w;
 
 	ihdr.width=w;
 	CVT_END_L(ihdr.width);
@@ -720,22 +768,25 @@ static void emitchunk(unsigned char **cpp,char *type,char *data,int length) {
 	ihdr.filter_method=0;
 	ihdr.interlace_method=0;
 
-	linebuf=malloc(hasalpha?(4*w+1):(3*w+1));
+	// Unfiltered current and previous rows, then a filter candidate:
+	rowbuf=calloc(3, rowbytes+1);
+	filtered=malloc((size_t)h*(rowbytes+1));
 	firstidat=currentidat=malloc(sizeof(struct idatnode));
 
-	if(!firstidat) {
-		free(linebuf);
+	if(!firstidat || !rowbuf || !filtered) {
+		free(rowbuf);
+		free(filtered);
+		free(firstidat);
 		trap_png();
 	}
-
 	currentidat->next=0;
-	deflateInit(&zstream, Z_DEFAULT_COMPRESSION);
-	zstream.next_out=currentidat->data;
-	zstream.avail_out=IDATLENGTH;
+	currentidat->length=0;
+
 	dp=codi->bits;
 	for(y=0;y<h;y++) {
-		cp=linebuf;
-		*cp++=0;
+		unsigned char *scan = rowbuf + (y & 1) * rowbytes;
+		unsigned char *prev = rowbuf + ((y + 1) & 1) * rowbytes;
+		cp=scan;
 		for(x=0;x<w;x++) {
 			cv=*dp++;
 			*cp++=cv>>16;
@@ -744,24 +795,63 @@ static void emitchunk(unsigned char **cpp,char *type,char *data,int length) {
 			if(hasalpha)
 				*cp++=cv>>24;
 		}
-		zstream.next_in=linebuf;
-		zstream.avail_in=(hasalpha?(4*w+1):(3*w+1));
-		while(zstream.avail_in||(y==h-1)) {
-			if(!zstream.avail_out)
-				goto refill;
-			ret=deflate(&zstream,(y==h-1)?Z_FINISH:0);
-			if((ret==Z_OK)||(ret==Z_BUF_ERROR))
-				continue;
-			if(ret==Z_STREAM_END)	
-				break;
+		cp = filtered + (size_t)y*(rowbytes+1);
+#ifdef INCLUDE_PNG_FILTER
+		filter_row(cp, scan, prev, rowbuf + 2 * rowbytes, rowbytes, bpp);
+#else
+		*cp=0;
+		memcpy(cp+1, scan, rowbytes);
+		(void)prev;
+#endif
+	}
 
+#ifdef INCLUDE_DEFLATE
+	// libdeflate levels are 0..12 (6 is its default too)
+	if(level < 0) level = 6;
+	if(!CompressZlib(filtered, (REBLEN)h*(rowbytes+1), level, &zipped, &zerr)) {
+		codi->error = CODI_ERR_ENCODING;
+		goto error;
+	}
+	zlen = SERIES_TAIL(zipped);
+	for(zpos=0; zpos<zlen; zpos+=IDATLENGTH) {
+		if(zpos) {
+			currentidat->next=malloc(sizeof(struct idatnode));
+			currentidat=currentidat->next;
+			if(!currentidat) {
+				codi->error = CODI_ERR_ENCODING;
+				goto error;
+			}
+			currentidat->next=0;
+		}
+		currentidat->length=MIN(IDATLENGTH, zlen-zpos);
+		memcpy(currentidat->data, BIN_SKIP(zipped, zpos), currentidat->length);
+	}
+	Free_Series(zipped);
+	zipped = NULL;
+#else
+	deflateInit(&zstream, (level < 0) ? Z_DEFAULT_COMPRESSION : MIN(level, 9));
+	zstream.next_in=filtered;
+	zstream.avail_in=h*(rowbytes+1);
+	zstream.next_out=currentidat->data;
+	zstream.avail_out=IDATLENGTH;
+	while(1) {
+		ret=deflate(&zstream,Z_FINISH);
+		if(ret==Z_STREAM_END)
+			break;
+		if((ret!=Z_OK)&&(ret!=Z_BUF_ERROR)) {
+			deflateEnd(&zstream);
 			codi->error = CODI_ERR_ENCODING;
 			goto error;
-
-		 refill:
+		}
+		if(!zstream.avail_out) {
 			currentidat->length=IDATLENGTH;
 			currentidat->next=malloc(sizeof(struct idatnode));
 			currentidat=currentidat->next;
+			if(!currentidat) {
+				deflateEnd(&zstream);
+				codi->error = CODI_ERR_ENCODING;
+				goto error;
+			}
 			currentidat->next=0;
 			zstream.next_out=currentidat->data;
 			zstream.avail_out=IDATLENGTH;
@@ -769,6 +859,8 @@ static void emitchunk(unsigned char **cpp,char *type,char *data,int length) {
 	}
 	currentidat->length=IDATLENGTH-zstream.avail_out;
 	deflateEnd(&zstream);
+#endif
+
 	imgsize=8+(12+13)+(12+19)+(12+0);
 	currentidat=firstidat;
 	while(currentidat) {
@@ -792,7 +884,11 @@ static void emitchunk(unsigned char **cpp,char *type,char *data,int length) {
 	emitchunk(&cp,"IEND",0,0);
 
 error:
-	free(linebuf);
+#ifdef INCLUDE_DEFLATE
+	if(zipped) Free_Series(zipped);
+#endif
+	free(rowbuf);
+	free(filtered);
 	while(firstidat) {
 		currentidat=firstidat->next;
 		free(firstidat);
@@ -0,0 +1,1024 @@
+/***********************************************************************
+**
+**  REBOL [R3] Language Interpreter and Run-time Environment
+**
+**  Copyright 2012 REBOL Technologies
+**  Copyright 2012-2026 Rebol Open Source Contributors
+**  REBOL is a trademark of REBOL Technologies
+**
+**  Licensed under the Apache License, Version 2.0 (the "License");
+**  you may not use this file except in compliance with the License.
+**  You may obtain a copy of the License at
+**
+**  http://www.apache.org/licenses/LICENSE-2.0
+**
+**  Unless required by applicable law or agreed to in writing, software
+**  distributed under the License is distributed on an "AS IS" BASIS,
+**  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+**  See the License for the specific language governing permissions and
+**  limitations under the License.
+**
+************************************************************************
+**
+**  Module:  u-rebin.c
+**  Summary: Rebol binary serialization (REBIN)
+**  Section: utility
+**  Notes:
+**
+**	Layout of the encoded data:
+**
+**		"REBIN" version value
+**
+**	Every value starts with its datatype byte. Bit 0x80 of the type
+**	byte holds the new-line marker of the value. Integers are stored
+**	as variable length quantities (LEB128, signed values zig-zag
+**	encoded), other scalars as little-endian fixed width numbers.
+**
+**	Words are interned: the first use of a word stores its UTF-8
+**	spelling, all following uses store only its table index.
+**
+**	Series (and object frames) get an id when first written. A series
+**	value stores: ref (0 = new series, else id), index and, for new
+**	series only, its content. That keeps shared series shared after
+**	decoding and makes cyclic structures possible. Words are decoded
+**	unbound (same as after LOAD); function bodies are bound the way
+**	DO binds a script (user context resolved from lib) and then to
+**	their arguments.
+**
+**	Raw vector and image data are stored in host byte order.
+**
+***********************************************************************/
+
+#include "sys-core.h"
+
+#ifdef INCLUDE_REBIN_CODEC
+
+#define REBIN_MAGIC       "REBIN"
+#define REBIN_MAGIC_LEN   5
+#define REBIN_VERSION     1
+#define REBIN_LINE_FLAG   0x80
+
+#define IS_BINSTR_TYPE(t) ((t) >= REB_BINARY && (t) <= REB_TAG)
+
+typedef struct rebin_encoder {
+	REBSER *out;        // resulting binary
+	REBSER *syms;       // word symbol -> index + 1 in the word table
+	REBCNT  num_words;  // number of words written
+	REBSER *seen;       // already written series (id = position + 1)
+	REBSER *hash;       // open addressing hash of ids in the seen list
+} REBIN_ENC;
+
+typedef struct rebin_decoder {
+	REBYTE *cp;         // current position
+	REBYTE *end;        // end of the input
+	REBSER *words;      // word table (symbols)
+	REBSER *refs;       // decoded series (id = position + 1)
+} REBIN_DEC;
+
+typedef struct rebin_ref {
+	REBSER *series;
+	REBCNT  type;       // datatype of the value that created the series
+} REBIN_REF;
+
+static void Encode_Value(REBIN_ENC *enc, REBVAL *val);
+static void Decode_Value(REBIN_DEC *dec, REBVAL *val);
+
+
+/***********************************************************************
+**
+**	Encoder
+**
+***********************************************************************/
+
+/***********************************************************************
+**
+*/	static REBYTE *Extend_Out(REBIN_ENC *enc, REBCNT len)
+/*
+**		Reserve len bytes at the tail of the output.
+**
+***********************************************************************/
+{
+	REBSER *out = enc->out;
+	REBCNT tail = SERIES_TAIL(out);
+	EXPAND_SERIES_TAIL(out, len);
+	return BIN_SKIP(out, tail);
+}
+
+static void Out_Byte(REBIN_ENC *enc, REBYTE b)
+{
+	*Extend_Out(enc, 1) = b;
+}
+
+static void Out_Bytes(REBIN_ENC *enc, const void *data, REBCNT len)
+{
+	if (len > 0) COPY_MEM(Extend_Out(enc, len), data, len);
+}
+
+static void Out_VLQ(REBIN_ENC *enc, REBU64 n)
+{
+	REBYTE buf[10];
+	REBCNT len = 0;
+	while (n >= 0x80) {
+		buf[len++] = (REBYTE)(n | 0x80);
+		n >>= 7;
+	}
+	buf[len++] = (REBYTE)n;
+	Out_Bytes(enc, buf, len);
+}
+
+static void Out_Signed(REBIN_ENC *enc, REBI64 n)
+{
+	Out_VLQ(enc, ((REBU64)n << 1) ^ (REBU64)(n >> 63)); // zig-zag
+}
+
+static void Out_U32(REBIN_ENC *enc, REBCNT n)
+{
+	REBYTE *bp = Extend_Out(enc, 4);
+	bp[0] = (REBYTE)n;
+	bp[1] = (REBYTE)(n >> 8);
+	bp[2] = (REBYTE)(n >> 16);
+	bp[3] = (REBYTE)(n >> 24);
+}
+
+static void Out_U64(REBIN_ENC *enc, REBU64 n)
+{
+	Out_U32(enc, (REBCNT)n);
+	Out_U32(enc, (REBCNT)(n >> 32));
+}
+
+
+/***********************************************************************
+**
+*/	static void Encode_Word(REBIN_ENC *enc, REBCNT sym)
+/*
+**		Write word table index (+1) of already used word,
+**		or zero followed by the UTF-8 spelling of a new one.
+**
+***********************************************************************/
+{
+	REBCNT *idx;
+	REBYTE *name;
+	REBCNT len;
+
+	// The decoder appends every spelled word to its table,
+	// so every spelled word must get its index here too:
+	if (sym >= (len = SERIES_TAIL(enc->syms))) {
+		EXPAND_SERIES_TAIL(enc->syms, sym + 1 - len);
+		CLEAR((REBCNT *)SERIES_DATA(enc->syms) + len, (sym + 1 - len) * sizeof(REBCNT));
+	}
+	idx = (REBCNT *)SERIES_DATA(enc->syms);
+
+	if (idx[sym]) {
+		Out_VLQ(enc, idx[sym]);
+		return;
+	}
+	idx[sym] = ++enc->num_words;
+
+	name = Get_Sym_Name(sym);
+	len = LEN_BYTES(name);
+	Out_VLQ(enc, 0);
+	Out_VLQ(enc, len);
+	Out_Bytes(enc, name, len);
+}
+
+
+/***********************************************************************
+**
+*/	static REBCNT Hash_Series_Ptr(REBSER *ser, REBCNT mask)
+/*
+***********************************************************************/
+{
+	REBUPT n = (REBUPT)ser >> 4;
+	return (REBCNT)((n ^ (n >> 16)) * 2654435761u) & mask;
+}
+
+
+/***********************************************************************
+**
+*/	static REBCNT Mark_Series(REBIN_ENC *enc, REBSER *ser)
+/*
+**		Returns id of the series if it was already written.
+**		Else it registers the series and returns zero.
+**
+***********************************************************************/
+{
+	REBSER **seen = (REBSER **)SERIES_DATA(enc->seen);
+	REBCNT *hash = (REBCNT *)SERIES_DATA(enc->hash);
+	REBCNT  mask = SERIES_TAIL(enc->hash) - 1;
+	REBCNT  n, id;
+
+	for (n = Hash_Series_Ptr(ser, mask); (id = hash[n]); n = (n + 1) & mask) {
+		if (seen[id - 1] == ser) return id;
+	}
+
+	EXPAND_SERIES_TAIL(enc->seen, 1);
+	seen = (REBSER **)SERIES_DATA(enc->seen);
+	id = SERIES_TAIL(enc->seen);
+	seen[id - 1] = ser;
+	hash[n] = id;
+
+	// Keep the hash at most half full:
+	if (id * 2 > mask) {
+		REBCNT size = (mask + 1) * 2;
+		REBSER *hser = Make_Series(size, sizeof(REBCNT), FALSE);
+		hser->tail = size;
+		hash = (REBCNT *)SERIES_DATA(hser);
+		for (id = 1; id <= SERIES_TAIL(enc->seen); id++) {
+			for (n = Hash_Series_Ptr(seen[id - 1], size - 1); hash[n]; n = (n + 1) & (size - 1));
+			hash[n] = id;
+		}
+		Free_Series(enc->hash);
+		enc->hash = hser;
+	}
+	return 0;
+}
+
+
+/***********************************************************************
+**
+*/	static REBFLG Encode_Series_Ref(REBIN_ENC *enc, REBSER *ser, REBCNT index)
+/*
+**		Writes the series reference and index.
+**		Returns TRUE when series content must follow.
+**
+***********************************************************************/
+{
+	REBCNT id = Mark_Series(enc, ser);
+	if (index > SERIES_TAIL(ser)) index = SERIES_TAIL(ser); // same as the value sees it
+	Out_VLQ(enc, id);
+	Out_VLQ(enc, index);
+	return id == 0;
+}
+
+
+/***********************************************************************
+**
+*/	static REBCNT Wide_UTF8_Size(REBUNI *up, REBCNT len)
+/*
+**		Returns the UTF-8 size of wide chars (the same as Encode_UTF8
+**		produces it, surrogate pairs are joined).
+**
+***********************************************************************/
+{
+	REBCNT size = 0;
+	REBUNI c;
+
+	for (; len > 0; len--) {
+		c = *up++;
+		if (c < 0x80) size++;
+		else if (c < 0x800) size += 2;
+		else if (c >= 0xD800 && c <= 0xDBFF && len > 1) {
+			size += 4;
+			up++;
+			len--;
+		}
+		else size += 3;
+	}
+	return size;
+}
+
+
+/***********************************************************************
+**
+*/	static void Encode_Wide_String(REBIN_ENC *enc, REBSER *ser, REBCNT index)
+/*
+**		Wide (REBUNI) strings are written as UTF-8 (the same as byte
+**		strings), so the index is converted to its UTF-8 byte offset.
+**
+***********************************************************************/
+{
+	REBCNT id = Mark_Series(enc, ser);
+	REBCNT tail = SERIES_TAIL(ser);
+	REBCNT size;
+	REBLEN len;
+
+	if (index > tail) index = tail;
+	Out_VLQ(enc, id);
+	Out_VLQ(enc, Wide_UTF8_Size(UNI_HEAD(ser), index));
+	if (id) return;
+
+	size = Wide_UTF8_Size(UNI_HEAD(ser), tail);
+	Out_Byte(enc, (REBYTE)(size > tail ? 1 : 0)); // not only ASCII
+	Out_VLQ(enc, size);
+	len = tail;
+	Encode_UTF8(Extend_Out(enc, size), size, UNI_HEAD(ser), &len, TRUE, FALSE);
+}
+
+
+/***********************************************************************
+**
+*/	static void Encode_Values(REBIN_ENC *enc, REBVAL *val, REBCNT len)
+/*
+***********************************************************************/
+{
+	Out_VLQ(enc, len);
+	for (; len > 0; len--, val++) Encode_Value(enc, val);
+}
+
+
+/***********************************************************************
+**
+*/	static void Encode_Value(REBIN_ENC *enc, REBVAL *val)
+/*
+***********************************************************************/
+{
+	REBCNT type = VAL_TYPE(val);
+	REBSER *ser;
+	REBCNT n, len;
+	REBVAL tmp;
+
+	CHECK_STACK(&val);
+
+	Out_Byte(enc, (REBYTE)(type | (VAL_GET_LINE(val) ? REBIN_LINE_FLAG : 0)));
+
+	switch (type) {
+
+	case REB_END:
+	case REB_UNSET:
+	case REB_NONE:
+		break;
+
+	case REB_LOGIC:
+		Out_Byte(enc, (REBYTE)(VAL_LOGIC(val) != 0));
+		break;
+
+	case REB_INTEGER:
+		Out_Signed(enc, VAL_INT64(val));
+		break;
+
+	case REB_DECIMAL:
+	case REB_PERCENT:
+		Out_U64(enc, VAL_UNT64(val)); // raw IEEE bits
+		break;
+
+	case REB_MONEY: {
+		REBYTE bin[12];
+		deci_to_binary(bin, VAL_DECI(val));
+		Out_Bytes(enc, bin, 12);
+		break;
+	}
+
+	case REB_CHAR:
+		Out_VLQ(enc, VAL_CHAR(val));
+		break;
+
+	case REB_PAIR: {
+		union {float f; REBCNT u;} x, y;
+		x.f = VAL_PAIR_X(val);
+		y.f = VAL_PAIR_Y(val);
+		Out_U32(enc, x.u);
+		Out_U32(enc, y.u);
+		break;
+	}
+
+	case REB_TUPLE:
+		len = VAL_TUPLE_LEN(val);
+		if (len > MAX_TUPLE) len = MAX_TUPLE;
+		Out_Byte(enc, (REBYTE)len);
+		Out_Bytes(enc, VAL_TUPLE(val), len);
+		break;
+
+	case REB_TIME:
+		Out_Signed(enc, VAL_TIME(val));
+		break;
+
+	case REB_DATE:
+		Out_U32(enc, VAL_DATE(val).bits);
+		Out_Signed(enc, VAL_TIME(val));
+		break;
+
+	case REB_DATATYPE:
+		Out_Byte(enc, (REBYTE)VAL_DATATYPE(val));
+		break;
+
+	case REB_TYPESET:
+		Out_U64(enc, VAL_TYPESET(val));
+		break;
+
+	case REB_WORD:
+	case REB_SET_WORD:
+	case REB_GET_WORD:
+	case REB_LIT_WORD:
+	case REB_REFINEMENT:
+	case REB_ISSUE:
+		Encode_Word(enc, VAL_WORD_SYM(val));
+		break;
+
+	case REB_BINARY:
+	case REB_STRING:
+	case REB_FILE:
+	case REB_EMAIL:
+	case REB_REF:
+	case REB_URL:
+	case REB_TAG:
+		ser = VAL_SERIES(val);
+		if (!BYTE_SIZE(ser)) Encode_Wide_String(enc, ser, VAL_INDEX(val));
+		else if (Encode_Series_Ref(enc, ser, VAL_INDEX(val))) {
+			Out_Byte(enc, (REBYTE)(IS_UTF8_SERIES(ser) ? 1 : 0));
+			Out_VLQ(enc, SERIES_TAIL(ser));
+			Out_Bytes(enc, BIN_HEAD(ser), SERIES_TAIL(ser));
+		}
+		break;
+
+	case REB_BITSET:
+		ser = VAL_SERIES(val);
+		if (Encode_Series_Ref(enc, ser, VAL_INDEX(val))) {
+			Out_Byte(enc, (REBYTE)(BITS_NOT(ser) ? 1 : 0));
+			Out_VLQ(enc, SERIES_TAIL(ser));
+			Out_Bytes(enc, BIN_HEAD(ser), SERIES_TAIL(ser));
+		}
+		break;
+
+	case REB_IMAGE:
+		ser = VAL_SERIES(val);
+		if (Encode_Series_Ref(enc, ser, VAL_INDEX(val))) {
+			Out_VLQ(enc, IMG_WIDE(ser));
+			Out_VLQ(enc, IMG_HIGH(ser));
+			Out_Bytes(enc, BIN_HEAD(ser), IMG_WIDE(ser) * IMG_HIGH(ser) * 4);
+		}
+		break;
+
+	case REB_VECTOR:
+		ser = VAL_SERIES(val);
+		if (Encode_Series_Ref(enc, ser, VAL_INDEX(val))) {
+			Out_U32(enc, ser->size);
+			Out_Byte(enc, (REBYTE)SERIES_WIDE(ser));
+			Out_VLQ(enc, SERIES_TAIL(ser));
+			Out_Bytes(enc, SERIES_DATA(ser), SERIES_TAIL(ser) * SERIES_WIDE(ser));
+		}
+		break;
+
+	case REB_BLOCK:
+	case REB_PAREN:
+	case REB_PATH:
+	case REB_SET_PATH:
+	case REB_GET_PATH:
+	case REB_LIT_PATH:
+	case REB_HASH:
+		ser = VAL_SERIES(val);
+		if (Encode_Series_Ref(enc, ser, VAL_INDEX(val)))
+			Encode_Values(enc, BLK_HEAD(ser), SERIES_TAIL(ser));
+		break;
+
+	case REB_MAP:
+		ser = VAL_SERIES(val);
+		if (Encode_Series_Ref(enc, ser, 0)) {
+			REBVAL *v = BLK_HEAD(ser);
+			for (n = len = 0; n < SERIES_TAIL(ser); n += 2) {
+				if (!VAL_MAP_REMOVED(v + n)) len += 2;
+			}
+			Out_VLQ(enc, len);
+			for (n = 0; n < SERIES_TAIL(ser); n += 2) {
+				if (VAL_MAP_REMOVED(v + n)) continue;
+				Encode_Value(enc, v + n);
+				Encode_Value(enc, v + n + 1);
+			}
+		}
+		break;
+
+	case REB_OBJECT:
+		ser = VAL_OBJ_FRAME(val);
+		if (Encode_Series_Ref(enc, ser, 0)) {
+			REBVAL *word = FRM_WORDS(ser);
+			len = SERIES_TAIL(ser) - 1;
+			Out_Byte(enc, (REBYTE)(IS_SELFLESS(ser) ? 1 : 0));
+			Out_VLQ(enc, len);
+			for (n = 1; n <= len; n++) {
+				Encode_Word(enc, VAL_BIND_SYM(word + n));
+				Out_Byte(enc, (REBYTE)(
+					(VAL_GET_OPT(word + n, OPTS_HIDE) ? 1 : 0) |
+					(VAL_GET_OPT(word + n, OPTS_LOCK) ? 2 : 0)
+				));
+			}
+			// values must be written after all words (decoder needs the frame first)
+			for (n = 1; n <= len; n++) Encode_Value(enc, FRM_VALUE(ser, n));
+		}
+		break;
+
+	case REB_FUNCTION:
+	case REB_CLOSURE:
+		Set_Block(&tmp, VAL_FUNC_SPEC(val));
+		Encode_Value(enc, &tmp);
+		Set_Block(&tmp, VAL_FUNC_BODY(val));
+		Encode_Value(enc, &tmp);
+		break;
+
+	default:
+		Trap1(RE_INVALID_ARG, val);
+	}
+}
+
+
+/***********************************************************************
+**
+*/	REBSER *Encode_Rebin(REBVAL *val)
+/*
+**		Serialize value into a new binary series.
+**
+***********************************************************************/
+{
+	REBIN_ENC enc;
+
+	CLEAR(&enc, sizeof(enc));
+	enc.out = Make_Binary(256);
+	enc.syms = Make_Series(SERIES_TAIL(PG_Word_Table.series) + 1, sizeof(REBCNT), FALSE);
+	enc.syms->tail = SERIES_TAIL(PG_Word_Table.series);
+	enc.seen = Make_Series(64, sizeof(REBSER *), FALSE);
+	enc.hash = Make_Series(128, sizeof(REBCNT), FALSE);
+	enc.hash->tail = 128;
+
+	Out_Bytes(&enc, REBIN_MAGIC, REBIN_MAGIC_LEN);
+	Out_Byte(&enc, REBIN_VERSION);
+	Encode_Value(&enc, val);
+	TERM_SERIES(enc.out);
+
+	Free_Series(enc.syms);
+	Free_Series(enc.seen);
+	Free_Series(enc.hash);
+	return enc.out;
+}
+
+
+/***********************************************************************
+**
+**	Decoder
+**
+***********************************************************************/
+
+#define BAD_REBIN(dec) Trap1(RE_INVALID_DATA, (dec)->arg)
+
+static REBYTE *In_Bytes(REBIN_DEC *dec, REBCNT len)
+{
+	REBYTE *bp = dec->cp;
+	if ((REBCNT)(dec->end - bp) < len) Trap0(RE_PAST_END);
+	dec->cp += len;
+	return bp;
+}
+
+static REBYTE In_Byte(REBIN_DEC *dec)
+{
+	return *In_Bytes(dec, 1);
+}
+
+static REBU64 In_VLQ(REBIN_DEC *dec)
+{
+	REBU64 n = 0;
+	REBCNT shift;
+	REBYTE b;
+	for (shift = 0; shift < 64; shift += 7) {
+		b = In_Byte(dec);
+		n |= (REBU64)(b & 0x7F) << shift;
+		if (!(b & 0x80)) return n;
+	}
+	BAD_REBIN(dec);
+	return 0;
+}
+
+static REBI64 In_Signed(REBIN_DEC *dec)
+{
+	REBU64 n = In_VLQ(dec);
+	return (REBI64)(n >> 1) ^ -(REBI64)(n & 1);
+}
+
+static REBCNT In_Count(REBIN_DEC *dec)
+{
+	REBU64 n = In_VLQ(dec);
+	if (n > MAX_I32) BAD_REBIN(dec);
+	return (REBCNT)n;
+}
+
+static REBCNT In_U32(REBIN_DEC *dec)
+{
+	REBYTE *bp = In_Bytes(dec, 4);
+	return bp[0] | (bp[1] << 8) | (bp[2] << 16) | ((REBCNT)bp[3] << 24);
+}
+
+static REBU64 In_U64(REBIN_DEC *dec)
+{
+	REBU64 lo = In_U32(dec);
+	return lo | ((REBU64)In_U32(dec) << 32);
+}
+
+
+/***********************************************************************
+**
+*/	static REBCNT Decode_Word(REBIN_DEC *dec)
+/*
+***********************************************************************/
+{
+	REBCNT idx = In_Count(dec);
+	REBCNT len;
+	REBCNT sym;
+
+	if (idx > 0) {
+		if (idx > SERIES_TAIL(dec->words)) BAD_REBIN(dec);
+		return ((REBCNT *)SERIES_DATA(dec->words))[idx - 1];
+	}
+	len = In_Count(dec);
+	if (len == 0) BAD_REBIN(dec);
+	sym = Make_Word(In_Bytes(dec, len), len);
+	if (!sym) BAD_REBIN(dec);
+	EXPAND_SERIES_TAIL(dec->words, 1);
+	((REBCNT *)SERIES_DATA(dec->words))[SERIES_TAIL(dec->words) - 1] = sym;
+	return sym;
+}
+
+
+/***********************************************************************
+**
+*/	static REBSER *Decode_Series_Ref(REBIN_DEC *dec, REBCNT type, REBCNT *index)
+/*
+**		Reads series reference and index. Returns already decoded
+**		series or NULL, when the content follows in the input.
+**
+***********************************************************************/
+{
+	REBCNT id = In_Count(dec);
+	REBIN_REF *ref;
+
+	*index = In_Count(dec);
+	if (id == 0) return NULL;
+	if (id > SERIES_TAIL(dec->refs)) BAD_REBIN(dec);
+	ref = (REBIN_REF *)SERIES_DATA(dec->refs) + id - 1;
+
+	// Series may be shared only by values of compatible types:
+	if (ref->type != type && !(
+		(IS_BINSTR_TYPE(ref->type) && IS_BINSTR_TYPE(type)) ||
+		(ANY_BLOCK_TYPE(ref->type) && ANY_BLOCK_TYPE(type))
+	)) BAD_REBIN(dec);
+	return ref->series;
+}
+
+
+/***********************************************************************
+**
+*/	static void Register_Series(REBIN_DEC *dec, REBSER *ser, REBCNT type)
+/*
+***********************************************************************/
+{
+	REBIN_REF *ref;
+	EXPAND_SERIES_TAIL(dec->refs, 1);
+	ref = (REBIN_REF *)SERIES_DATA(dec->refs) + SERIES_TAIL(dec->refs) - 1;
+	ref->series = ser;
+	ref->type = type;
+}
+
+
+/***********************************************************************
+**
+*/	static REBSER *Decode_Block_Series(REBIN_DEC *dec, REBCNT type)
+/*
+***********************************************************************/
+{
+	REBCNT len = In_Count(dec);
+	REBSER *ser;
+	REBVAL tmp;
+
+	// every value takes at least one byte:
+	if (len > (REBCNT)(dec->end - dec->cp)) Trap0(RE_PAST_END);
+
+	ser = Make_Block(len);
+	Register_Series(dec, ser, type);
+	for (; len > 0; len--) {
+		Decode_Value(dec, &tmp);
+		*Append_Value(ser) = tmp;
+	}
+	return ser;
+}
+
+
+/***********************************************************************
+**
+*/	static void Decode_Value(REBIN_DEC *dec, REBVAL *val)
+/*
+***********************************************************************/
+{
+	REBYTE byte = In_Byte(dec);
+	REBCNT type = byte & ~REBIN_LINE_FLAG;
+	REBSER *ser;
+	REBCNT n, len, index = 0;
+
+	CHECK_STACK(&val);
+
+	switch (type) {
+
+	case REB_END:
+	case REB_UNSET:
+	case REB_NONE:
+		VAL_SET(val, type);
+		break;
+
+	case REB_LOGIC:
+		SET_LOGIC(val, In_Byte(dec));
+		break;
+
+	case REB_INTEGER:
+		SET_INTEGER(val, In_Signed(dec));
+		break;
+
+	case REB_DECIMAL:
+	case REB_PERCENT:
+		VAL_SET(val, type);
+		VAL_UNT64(val) = In_U64(dec);
+		break;
+
+	case REB_MONEY:
+		SET_MONEY(val, binary_to_deci(In_Bytes(dec, 12)));
+		break;
+
+	case REB_CHAR:
+		n = In_Count(dec);
+		if (n > MAX_CHAR) BAD_REBIN(dec);
+		SET_CHAR(val, n);
+		break;
+
+	case REB_PAIR: {
+		union {float f; REBCNT u;} x, y;
+		x.u = In_U32(dec);
+		y.u = In_U32(dec);
+		SET_PAIR(val, x.f, y.f);
+		break;
+	}
+
+	case REB_TUPLE:
+		len = In_Byte(dec);
+		if (len > MAX_TUPLE) BAD_REBIN(dec);
+		VAL_SET(val, REB_TUPLE);
+		CLEAR(VAL_TUPLE(val), MAX_TUPLE);
+		COPY_MEM(VAL_TUPLE(val), In_Bytes(dec, len), len);
+		VAL_SET_EXT(val, len);
+		break;
+
+	case REB_TIME:
+		VAL_SET(val, REB_TIME);
+		VAL_TIME(val) = In_Signed(dec);
+		break;
+
+	case REB_DATE:
+		VAL_SET(val, REB_DATE);
+		VAL_DATE(val).bits = In_U32(dec);
+		VAL_TIME(val) = In_Signed(dec);
+		break;
+
+	case REB_DATATYPE:
+		n = In_Byte(dec);
+		if (n >= REB_MAX) BAD_REBIN(dec);
+		Set_Datatype(val, n);
+		break;
+
+	case REB_TYPESET:
+		VAL_SET(val, REB_TYPESET);
+		VAL_TYPESET(val) = In_U64(dec);
+		break;
+
+	case REB_WORD:
+	case REB_SET_WORD:
+	case REB_GET_WORD:
+	case REB_LIT_WORD:
+	case REB_REFINEMENT:
+	case REB_ISSUE:
+		Init_Word(val, Decode_Word(dec));
+		VAL_SET(val, type);
+		break;
+
+	case REB_BINARY:
+	case REB_STRING:
+	case REB_FILE:
+	case REB_EMAIL:
+	case REB_REF:
+	case REB_URL:
+	case REB_TAG:
+	case REB_BITSET:
+		ser = Decode_Series_Ref(dec, type, &index);
+		if (!ser) {
+			REBFLG flag = In_Byte(dec);
+			len = In_Count(dec);
+			ser = Make_Binary(len);
+			COPY_MEM(BIN_HEAD(ser), In_Bytes(dec, len), len);
+			SERIES_TAIL(ser) = len;
+			if (type == REB_BITSET) BITS_NOT(ser) = flag != 0;
+			else if (flag) UTF8_SERIES(ser);
+			Register_Series(dec, ser, type);
+		}
+		Set_Series(type, val, ser);
+		break;
+
+	case REB_IMAGE:
+		ser = Decode_Series_Ref(dec, type, &index);
+		if (!ser) {
+			REBCNT w = In_Count(dec);
+			REBCNT h = In_Count(dec);
+			if ((REBU64)w * h * 4 > (REBU64)(dec->end - dec->cp)) Trap0(RE_PAST_END);
+			ser = Make_Image(w, h, TRUE);
+			COPY_MEM(IMG_DATA(ser), In_Bytes(dec, w * h * 4), w * h * 4);
+			Register_Series(dec, ser, type);
+		}
+		SET_IMAGE(val, ser);
+		break;
+
+	case REB_VECTOR:
+		ser = Decode_Series_Ref(dec, type, &index);
+		if (!ser) {
+			REBCNT size = In_U32(dec);
+			REBCNT wide = In_Byte(dec);
+			len = In_Count(dec);
+			if (wide != VECT_BYTE_SIZE(size & 0xff)) BAD_REBIN(dec);
+			if ((REBU64)len * wide > (REBU64)(dec->end - dec->cp)) Trap0(RE_PAST_END);
+			ser = Make_Series(len + 1, wide, TRUE);
+			LABEL_SERIES(ser, "make vector");
+			COPY_MEM(SERIES_DATA(ser), In_Bytes(dec, len * wide), len * wide);
+			ser->tail = len;
+			ser->size = size;
+			Register_Series(dec, ser, type);
+		}
+		Set_Series(type, val, ser);
+		break;
+
+	case REB_BLOCK:
+	case REB_PAREN:
+	case REB_PATH:
+	case REB_SET_PATH:
+	case REB_GET_PATH:
+	case REB_LIT_PATH:
+	case REB_HASH:
+		ser = Decode_Series_Ref(dec, type, &index);
+		if (!ser) ser = Decode_Block_Series(dec, type);
+		Set_Series(type, val, ser);
+		break;
+
+	case REB_MAP:
+		ser = Decode_Series_Ref(dec, type, &index);
+		if (!ser) {
+			ser = Decode_Block_Series(dec, type);
+			if (SERIES_TAIL(ser) & 1) BAD_REBIN(dec);
+			Block_As_Map(ser);
+		}
+		Set_Series(type, val, ser);
+		break;
+
+	case REB_OBJECT:
+		ser = Decode_Series_Ref(dec, type, &index);
+		if (!ser) {
+			REBFLG selfless = In_Byte(dec);
+			REBVAL tmp;
+			len = In_Count(dec);
+			if (len > (REBCNT)(dec->end - dec->cp)) Trap0(RE_PAST_END);
+			ser = Make_Frame(len);
+			if (selfless) SET_SELFLESS(ser);
+			for (n = 1; n <= len; n++) {
+				REBYTE opts;
+				Append_Frame(ser, 0, Decode_Word(dec));
+				opts = In_Byte(dec);
+				if (opts & 1) VAL_SET_OPT(FRM_WORD(ser, n), OPTS_HIDE);
+				if (opts & 2) VAL_SET_OPT(FRM_WORD(ser, n), OPTS_LOCK);
+			}
+			Register_Series(dec, ser, type);
+			for (n = 1; n <= len; n++) {
+				Decode_Value(dec, &tmp);
+				*FRM_VALUE(ser, n) = tmp;
+			}
+		}
+		SET_OBJECT(val, ser);
+		break;
+
+	case REB_FUNCTION:
+	case REB_CLOSURE: {
+		REBVAL def;
+		REBVAL *body;
+		REBSER *user;
+		REBVAL vali;
+		Set_Block(&def, Make_Block(2));
+		SAVE_SERIES(VAL_SERIES(&def));
+		Decode_Value(dec, Append_Value(VAL_SERIES(&def)));
+		body = Append_Value(VAL_SERIES(&def));
+		Decode_Value(dec, body);
+		if (IS_BLOCK(body)) {
+			user = VAL_OBJ_FRAME(Get_System(SYS_CONTEXTS, CTX_USER));
+			SET_INTEGER(&vali, SERIES_TAIL(user));
+			Bind_Block(user, VAL_BLK_DATA(body), BIND_ALL | BIND_DEEP);
+			Resolve_Context(user, Lib_Context, &vali, FALSE, 0);
+		}
+		if (!Make_Function(type, val, &def)) BAD_REBIN(dec);
+		UNSAVE_SERIES(VAL_SERIES(&def));
+		break;
+	}
+
+	default:
+		BAD_REBIN(dec);
+	}
+
+	if (ANY_SERIES(val)) {
+		if (index > SERIES_TAIL(VAL_SERIES(val))) BAD_REBIN(dec);
+		VAL_INDEX(val) = index;
+	}
+	if (byte & REBIN_LINE_FLAG) VAL_SET_LINE(val);
+}
+
+
+/***********************************************************************
+**
+*/	void Decode_Rebin(REBVAL *out, REBYTE *data, REBCNT len)
+/*
+**		Deserialize value from binary data.
+**
+***********************************************************************/
+{
+	REBIN_DEC dec;
+
+	CLEAR(&dec, sizeof(dec));
+	dec.cp  = data;
+	dec.end = data + len;
+
+	if (
+		(REBCNT)(dec.end - dec.cp) <= REBIN_MAGIC_LEN
+		|| memcmp(dec.cp, REBIN_MAGIC, REBIN_MAGIC_LEN)
+	) Trap0(RE_BAD_DECODE);
+	dec.cp += REBIN_MAGIC_LEN;
+	if (*dec.cp++ != REBIN_VERSION) Trap0(RE_BAD_DECODE);
+
+	dec.words = Make_Series(64, sizeof(REBCNT), FALSE);
+	dec.refs  = Make_Series(64, sizeof(REBIN_REF), FALSE);
+
+	Decode_Value(&dec, out);
+
+	Free_Series(dec.words);
+	Free_Series(dec.refs);
+}
+
+
+/***********************************************************************
+**
+*/	REBNATIVE(encode_rebin)
+/*
+//	encode-rebin: native [
+//		"Serializes a value into the compact binary REBIN format"
+//		value [any-type!]
+//	]
+***********************************************************************/
+{
+	Set_Binary(D_RET, Encode_Rebin(D_ARG(1)));
+	return R_RET;
+}
+
+
+/***********************************************************************
+**
+*/	REBNATIVE(decode_rebin)
+/*
+//	decode-rebin: native [
+//		"Deserializes a value from the REBIN binary format"
+//		data [binary!]
+//	]
+***********************************************************************/
+{
+	Decode_Rebin(D_RET, VAL_BIN_DATA(D_ARG(1)), VAL_LEN(D_ARG(1)));
+	return R_RET;
+}
+
+
+/***********************************************************************
+**
+*/	REBINT Codec_REBIN(REBCDI *codi)
+/*
+**		The value to encode is passed in ->other and it is replaced
+**		with the result. On decode ->other points to the result value.
+**
+***********************************************************************/
+{
+	REBVAL *val = (REBVAL *)codi->other;
+
+	codi->error = 0;
+
+	if (codi->action == CODI_IDENTIFY) {
+		if (
+			codi->len <= REBIN_MAGIC_LEN
+			|| memcmp(codi->data, REBIN_MAGIC, REBIN_MAGIC_LEN)
+		) codi->error = CODI_ERR_SIGNATURE;
+		return CODI_CHECK; // error code is inverted result
+	}
+
+	if (codi->action == CODI_DECODE) {
+		Decode_Rebin(val, codi->data, codi->len);
+		return CODI_VALUE;
+	}
+
+	if (codi->action == CODI_ENCODE_VALUE) {
+		Set_Binary(val, Encode_Rebin(val));
+		return CODI_VALUE;
+	}
+
+	codi->error = CODI_ERR_NA;
+	return CODI_ERROR;
+}
+
+
+/***********************************************************************
+**
+*/	void Init_REBIN_Codec(void)
+/*
+***********************************************************************/
+{
+	Register_Codec("rebin", Codec_REBIN);
+}
+
+#endif //INCLUDE_REBIN_CODEC
@@ -70,6 +70,7 @@ enum arg_opts {
 	ROF_BOOT,
 	ROF_NO_WINDOW,
 	ROF_NO_COLOR,
+	ROF_PROFILE,
 
 	ROF_IGNORE, // not an option
 };
@@ -94,6 +95,7 @@ enum arg_opts {
 #define RO_BOOT        (1<<ROF_BOOT)
 #define RO_NO_WINDOW   (1<<ROF_NO_WINDOW)
 #define RO_NO_COLOR    (1<<ROF_NO_COLOR)
+#define RO_PROFILE     (1<<ROF_PROFILE)
 
 #define RO_IGNORE      (1<<ROF_IGNORE)
 
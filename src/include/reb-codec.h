@@ -48,6 +48,11 @@
 // the REBNATIVE(do_codec) in n-system.c
 // so the deallocation is left to GC
 //
+// If your codec routine returns CODI_VALUE, the result is
+// already stored in the value pointed to by the ->other field.
+// Values other than images are encoded with CODI_ENCODE_VALUE
+// and are passed in the same field.
+//
 struct reb_codec_image {
 	int action;
 	int w;
@@ -63,6 +68,7 @@ struct reb_codec_image {
 		void *other;
 	};
 	int error;
+	int level;  // codec specific option: compression level, quality or decode scale (-1 = default)
 };
 
 typedef struct reb_codec_image REBCDI;
@@ -79,6 +85,7 @@ enum {
 	CODI_SOUND,
 	CODI_BLOCK,
 	CODI_STRING,			// result is in codi->other as a series (no need to copy).
+	CODI_VALUE,				// result is in the value codi->other points to.
 };
 
 // Codec commands:
@@ -86,6 +93,7 @@ enum {
 	CODI_IDENTIFY,
 	CODI_DECODE,
 	CODI_ENCODE,
+	CODI_ENCODE_VALUE,		// encode any value (codi->other), not just an image
 };
 
 // Codec errors:
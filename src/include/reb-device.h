@@ -220,6 +220,13 @@ struct rebol_devreq {
 			u32  remote_ip;			// remote address
 			u32  remote_port;		// remote port
 			void *host_info;		// for DNS usage
+			union {					// source file of RSM_SENDFILE transfer
+				void *file_handle;	// Windows file handle
+				int file_id;		// POSIX file descriptor
+			};
+			i64  file_offset;		// position in the source file
+			u32  read_size;			// adaptive size of the receive buffer
+			void *batch;			// UDP receive buffer of RSM_BATCH mode (REBNETB)
 		} net;
 		struct {
 			u32  buffer_rows;
@@ -37,10 +37,12 @@ enum {
 	RFM_READONLY,
 	RFM_TRUNCATE,
 	RFM_RESEEK,			// file index has moved, reseek
+	RFM_SENDING,		// file is the source of a pending net WRITE
 //	RFM_NAME_MEM,		// converted name allocated in mem
 	RFM_DIR = 16,
 	RFM_DRIVES,         // used only on Windows to get logical drives letters (read %/)
 	RFM_PATTERN,        // used only on Posix for reading wildcard patterns (read %*.txt)
+	RFM_INFO,           // dir entries also report size and dates (read/all %dir/)
 };
 
 // RFE - REBOL File Error
@@ -43,6 +43,29 @@ enum {
 	RSM_SEND,					// sending
 	RSM_RECEIVE,				// receiving
 	RSM_ACCEPT,					// an inbound connection
+	RSM_SENDFILE,				// sending content of a file (not data)
+	RSM_GATHER,					// sending list of buffers (data is REBIOV list)
+	RSM_BATCH,					// UDP datagrams are received into net.batch
 };
 
+// Buffer of a gather write (list ends with zero data):
+typedef struct rebol_io_vec {
+	REBYTE *data;
+	u32 length;
+} REBIOV;
+
+// Received datagrams of the UDP batch mode:
+#define NET_BATCH_MAX  16			// max datagrams received by one read
+#define NET_BATCH_SLOT 4096			// max datagram size (longer are refused)
+
+typedef struct rebol_net_batch {
+	u32 count;						// number of received datagrams
+	struct {
+		u32 length;
+		u32 remote_ip;
+		u32 remote_port;
+	} info[NET_BATCH_MAX];
+	REBYTE data[NET_BATCH_MAX][NET_BATCH_SLOT];
+} REBNETB;
+
 #define IPA(a,b,c,d) (a<<24 | b<<16 | c<<8 | d)
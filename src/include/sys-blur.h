@@ -1,6 +1,8 @@
 #ifndef __INCLUDE_BLUR_H__
 #define __INCLUDE_BLUR_H__
 
+#define BLUR_BAND 1024 // byte columns per band of the vertical pass
+
 void BlurImage(REBSER *image, REBCNT radius);
 
 #endif
@@ -97,7 +97,7 @@ typedef struct rebol_port_action_map {
 } PORT_ACTION;
 
 typedef struct rebol_mold {
-	REBSER *series;		// destination series (uni)
+	REBSER *series;		// destination series (UTF-8)
 	REBCNT opts;		// special option flags
 	REBINT indent;		// indentation amount
 //	REBYTE space;		// ?
@@ -105,6 +105,9 @@ typedef struct rebol_mold {
 	REBYTE dash;		// for date fields
 	REBYTE digits;		// decimal digits
 	REBCNT limit;       // optional length limit of the result (-1 = no limit)
+	REBCNT chunk;       // if not zero, the buffer is flushed when it grows over this size
+	void (*flush)(struct rebol_mold *); // consumes the buffer content when flushing
+	void *stream;       // target used by the flush function (file request, etc.)
 } REB_MOLD;
 
 #include "reb-file.h"
@@ -159,6 +162,7 @@ enum {
 };
 
 #define CP_DEEP TYPESET(63)
+#define CP_SHARE TYPESET(62)	// share strings copy-on-write (see Share_Series)
 
 #define TS_NOT_COPIED (TYPESET(REB_IMAGE) | TYPESET(REB_VECTOR) | TYPESET(REB_TASK) | TYPESET(REB_PORT))
 #define TS_STD_SERIES (TS_SERIES & ~TS_NOT_COPIED)
@@ -170,6 +174,7 @@ enum {
 
 #define TS_FUNCLOS (TYPESET(REB_FUNCTION) | TYPESET(REB_CLOSURE))
 #define TS_CLONE ((CP_DEEP | TS_SERIES | TS_FUNCLOS | TYPESET(REB_MAP)) & ~TS_NOT_COPIED)
+#define TS_CLONE_SHARED (TS_CLONE | CP_SHARE)
 
 // Modes allowed by Bind related functions:
 enum {
@@ -418,6 +423,7 @@ typedef struct rebol_stats {
 	REBCNT	Recycle_Series_Total;
 	REBCNT	Recycle_Series;
 	REBI64  Recycle_Prior_Eval;
+	REBI64  Recycle_Time;	// microseconds spent in Recycle
 	REBCNT	Mark_Count;
 	REBCNT	Free_List_Checked;
 	REBCNT	Blocks;
@@ -89,6 +89,8 @@ TVAR REBSER *Task_Series;	// Series that holds Task_Context
 TVAR REBPOL *Mem_Pools;		// Memory pool array
 TVAR REBCNT	GC_Disabled;	// GC disabled counter for critical sections.
 TVAR REBINT	GC_Ballast;		// Bytes allocated to force automatic GC
+TVAR REBINT	GC_Pace;		// Ballast computed by the last recycle (see Pace_Recycle)
+TVAR REBINT	GC_Growth;		// Percent of live memory allocated before next recycle
 TVAR REBOOL	GC_Active;		// TRUE when recycle is enabled (set by RECYCLE func)
 TVAR REBSER	*GC_Protect;	// A stack of protected series (removed by pop)
 TVAR REBSER	*GC_Series;		// An array of protected series (removed by address)
@@ -107,6 +109,7 @@ TVAR REBINT	DSP;			// Data stack pointer
 TVAR REBINT	DSF;			// Data stack frame (function base)
 
 TVAR jmp_buf *Saved_State;	// Pointer to saved CPU state for error handlers.
+TVAR REBFLG Trap_Quiet;		// Innermost handler discards the error (ATTEMPT)
 
 //-- Evaluation variables:
 TVAR REBI64	Eval_Cycles;	// Total evaluation counter (upward)
@@ -124,6 +127,9 @@ TVAR REBSER *Trace_Buffer;	// Holds backtrace lines
 TVAR REBI64 Eval_Natives;
 TVAR REBI64 Eval_Functions;
 
+TVAR REBINT Profile_Interval; // Sampling profiler interval in microseconds (0 = off)
+TVAR REBFLG Call_Stats_Active; // Per-function call statistics are collected
+
 #ifdef DEBUG_HASH_COLLISIONS
 TVAR REBI64 Eval_Collisions; // Hash collisions
 #endif
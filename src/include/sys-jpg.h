@@ -309,12 +309,20 @@ typedef int boolean;
 #define D_PROGRESSIVE_SUPPORTED	    /* Progressive JPEG? (Requires MULTISCAN)*/
 //#define SAVE_MARKERS_SUPPORTED	    /* jpeg_save_markers() needed? */
 //#define BLOCK_SMOOTHING_SUPPORTED   /* Block smoothing? (Progressive only) */
-//#define IDCT_SCALING_SUPPORTED	    /* Output rescaling via IDCT? */
+#define IDCT_SCALING_SUPPORTED	    /* Output rescaling via IDCT? */
 //#undef  UPSAMPLE_SCALING_SUPPORTED  /* Output rescaling at upsample stage? */
 //#define UPSAMPLE_MERGING_SUPPORTED  /* Fast path for sloppy upsampling? */
 #define QUANT_1PASS_SUPPORTED	    /* 1-pass color quantization? */
 //#define QUANT_2PASS_SUPPORTED	    /* 2-pass color quantization? */
 
+/* SIMD kernels. SSE2 is part of every x86-64 CPU, so it is selected
+ * at compile time; define NO_JPEG_SIMD to use the plain C versions.
+ */
+#if !defined(NO_JPEG_SIMD) && \
+    (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define JPEG_SIMD_SSE2
+#endif
+
 /* more capability options later, no doubt */
 
 
@@ -2577,6 +2585,11 @@ EXTERN(void) jpeg_idct_2x2
 EXTERN(void) jpeg_idct_1x1
     JPP((j_decompress_ptr cinfo, jpeg_component_info * compptr,
 	 JCOEFPTR coef_block, JSAMPARRAY output_buf, JDIMENSION output_col));
+#ifdef JPEG_SIMD_SSE2
+EXTERN(void) jpeg_idct_islow_sse2
+    JPP((j_decompress_ptr cinfo, jpeg_component_info * compptr,
+	 JCOEFPTR coef_block, JSAMPARRAY output_buf, JDIMENSION output_col));
+#endif
 
 
 /*
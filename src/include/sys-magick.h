@@ -64,6 +64,7 @@
 #define DefaultThumbnailFilter BoxFilter
 #define MagickEpsilon 1.0e-12
 #define MagickPI 3.14159265358979323846264338327950288419716939937510
+#define RESIZE_CONTRIBUTIONS 65536 // max filter contributions computed at once
 
 
 // Typedef declarations.
@@ -101,6 +102,13 @@ typedef struct _PixelPacket
 #endif
 } PixelPacket;
 
+// SSE2 is part of every x86-64 CPU; define NO_MAGICK_SIMD to use plain C.
+#if !defined(NO_MAGICK_SIMD) && defined(MAGICK_PIXELS_BGRA) && \
+    (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define MAGICK_SIMD_SSE2
+#include <emmintrin.h>
+#endif
+
 typedef struct _DoublePixelPacket
 {
   double
@@ -134,7 +142,7 @@ typedef enum
 
 REBSER *ResizeImage(const REBSER *image,const REBCNT columns,
 					const REBCNT rows,const FilterTypes filter,
-					const REBDEC blur, REBOOL has_alpha);
+					const REBDEC blur, REBOOL has_alpha, REBSER *target);
 
 
 // Defines
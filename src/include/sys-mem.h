@@ -114,6 +114,7 @@ typedef void *REBNOD;			// Just used for linking free nodes
 #endif
 
 #define MEM_BALLAST 3000000
+#define GC_GROWTH 50	// default GC_Growth (percent of live memory)
 
 // Disable GC - Only necessary if DO_NEXT with non-referenced series.
 #define DISABLE_GC		GC_Disabled++
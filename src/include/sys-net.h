@@ -41,6 +41,7 @@
 #define NE_ALREADY		WSAEALREADY
 #define NE_NOTCONN		WSAENOTCONN
 #define NE_INVALID		WSAEINVAL
+#define NE_MSGSIZE		WSAEMSGSIZE
 
 //----- BSD - The network standard the rest of the world uses
 #else
@@ -56,6 +57,7 @@ typedef long __LONG;
 #include <fcntl.h>
 #include <netdb.h>
 #include <sys/socket.h>
+#include <sys/uio.h>
 #include <netinet/in.h>
 #include <unistd.h>
 
@@ -70,6 +72,7 @@ typedef long __LONG;
 #define NE_ALREADY		EALREADY
 #define NE_NOTCONN		ENOTCONN
 #define NE_INVALID		EINVAL
+#define NE_MSGSIZE		EMSGSIZE
 
 // Null Win32 functions:
 #define WSADATA int
@@ -93,4 +96,5 @@ typedef struct sockaddr_in SOCKAI; // Internet extensions
 
 #define BAD_SOCKET (~0)
 #define MAX_TRANSFER 32000		// Max send/recv buffer size
+#define MAX_GATHER 64			// Max buffers sent by one gather write call
 #define MAX_HOST_NAME 256		// Max length of host name
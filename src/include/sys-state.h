@@ -33,6 +33,7 @@ typedef struct {		// State variables to save
 	REBINT	dsf;
 	REBINT	hold_tail;	// Tail for GC_Protect
 	REBSER	*error;
+	REBFLG	quiet;		// Trap_Quiet of the enclosing frame
 	jmp_buf cpu_state;
 } REBOL_STATE;
 
@@ -44,6 +45,8 @@ typedef struct {		// State variables to save
 		(s).dsf = DSF;\
 		(s).hold_tail = GC_Protect->tail;\
 		(s).error = 0;\
+		(s).quiet = Trap_Quiet;\
+		Trap_Quiet = FALSE;\
 	} while(0)
 
 #define POP_STATE(s, g) do {\
@@ -51,6 +54,7 @@ typedef struct {		// State variables to save
 		DSP = (s).dsp;\
 		DSF = (s).dsf;\
 		GC_Protect->tail = (s).hold_tail;\
+		Trap_Quiet = (s).quiet;\
 	} while (0)
 
 // Do not restore prior state:
@@ -59,10 +63,17 @@ typedef struct {		// State variables to save
 // Set the pointer for the prior state:
 #define	SET_STATE(s, g) g = &(s).cpu_state
 
-// Store all CPU registers into the structure:
+// Store all CPU registers into the structure.
+// The signal mask is never saved: it costs a sigprocmask syscall on
+// every TRY, ATTEMPT or CATCH, and no error is ever thrown from inside
+// a signal handler (host handlers only set flags for Do_Signals).
+// On BSD and OSX plain setjmp saves the mask, so _setjmp is used there.
 #ifdef HAS_POSIX_SIGNAL
-#define	SET_JUMP(s) sigsetjmp((s).cpu_state, 1)
+#define	SET_JUMP(s) sigsetjmp((s).cpu_state, 0)
 #define	LONG_JUMP(s, v) siglongjmp((s), (v))
+#elif !defined(TO_WINDOWS)
+#define	SET_JUMP(s) _setjmp((s).cpu_state)
+#define	LONG_JUMP(s, v) _longjmp((s), (v))
 #else
 #define	SET_JUMP(s) setjmp((s).cpu_state)
 #define	LONG_JUMP(s, v) longjmp((s), (v))
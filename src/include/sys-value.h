@@ -448,8 +448,8 @@ static REBCNT byte_sizes[4] = { 1, 2, 4, 8 };
 
 // Optimized expand when at tail (but, does not reterminate)
 #define EXPAND_SERIES_TAIL(s,l) if (SERIES_FITS(s, l)) s->tail += l; else Expand_Series(s, AT_TAIL, l)
-#define RESIZE_SERIES(s,l) s->tail = 0; if (!SERIES_FITS(s, l)) Expand_Series(s, AT_TAIL, l); s->tail = 0
-#define RESET_TAIL(s) s->tail = 0; SERIES_CLR_FLAG(s, SER_UTF8);
+#define RESIZE_SERIES(s,l) s->tail = 0; UNSHARE_SERIES(s); if (!SERIES_FITS(s, l)) Expand_Series(s, AT_TAIL, l); s->tail = 0
+#define RESET_TAIL(s) s->tail = 0; UNSHARE_SERIES(s); SERIES_CLR_FLAG(s, SER_UTF8);
 #define RESET_SERIES(s) RESET_TAIL(s); TERM_SERIES(s);
 
 // Clear all and clear to tail:
@@ -482,6 +482,9 @@ enum {
 	SER_MON  = 1<<7,	// Monitoring
 	SER_INT  = 1<<8,	// Series data is internal (loop frames) and should not be accessed by users
 	SER_UTF8 = 1<<9,	// Series contains not only ASCII characters
+	SER_COW  = 1<<10,	// Series data is shared with series->series until modified
+	SER_SNAP = 1<<11,	// Series->series holds a snapshot shared by COW series
+	SER_SWEEP = 1<<12,	// Series was found unmarked by the parallel sweep (to be freed)
 };
 
 #define SERIES_SET_FLAG(s, f) (SERIES_FLAGS(s) |=  (f))
@@ -508,7 +511,14 @@ enum {
 #define IS_UTF8_SERIES(s)    SERIES_GET_FLAG(s, SER_UTF8)
 #define IS_UTF8_STRING(v)    SERIES_GET_FLAG(VAL_SERIES(v), SER_UTF8)
 
-#define TRAP_PROTECT(s) if (IS_PROTECT_SERIES(s)) Trap0(RE_PROTECTED)
+#define IS_COW_SERIES(s)     SERIES_GET_FLAG(s, SER_COW)
+#define UNSHARE_SERIES(s)    if (IS_COW_SERIES(s)) Unshare_Series(s)
+
+// Check before modifying a series (also gives a COW series its own data):
+#define TRAP_PROTECT(s) do {\
+		if (IS_PROTECT_SERIES(s)) Trap0(RE_PROTECTED);\
+		UNSHARE_SERIES(s);\
+	} while (0)
 
 #ifdef SERIES_LABELS
 #define LABEL_SERIES(s,l) s->label = (l)
@@ -659,6 +669,9 @@ typedef struct Reb_Series_Ref
 			if (MOLD_OVER_LIMIT(mold)) return;                \
 			if (MOLD_REST(mold) < len) len = MOLD_REST(mold); \
 		}
+// chunked mold output (used to stream large data into files)
+#define MOLD_NEEDS_FLUSH(mold) (mold->chunk && mold->series->tail >= mold->chunk)
+#define CHECK_MOLD_FLUSH(mold) if (MOLD_NEEDS_FLUSH(mold)) mold->flush(mold)
 
 /***********************************************************************
 **
@@ -897,6 +910,12 @@ typedef struct Reb_Frame {
 
 #define VAL_FRM_WORD(v,n)	BLK_SKIP(FRM_WORD_SERIES(VAL_SERIES(v)),(n))
 
+// Word variable lookup; object-bound words are resolved inline, stack
+// relative and unbound words go through Get_Var (w is evaluated twice):
+#define GET_VAR(w) \
+	((VAL_WORD_FRAME(w) && VAL_WORD_INDEX(w) >= 0) \
+		? FRM_VALUES(VAL_WORD_FRAME(w)) + VAL_WORD_INDEX(w) : Get_Var(w))
+
 // Object field (series, index):
 #define OFV(s,n)			BLK_SKIP(s,n)
 
@@ -36,6 +36,10 @@
 **
 ***********************************************************************/
 
+#if defined(TO_LINUX) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE // for recvmmsg
+#endif
+
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -44,6 +48,14 @@
 #include "host-lib.h"
 #include "sys-net.h"
 
+#if defined(TO_LINUX) && !defined(__HAIKU__)
+#include <sys/sendfile.h>
+#include <signal.h>
+#include <errno.h>
+#define USE_SENDFILE
+#define USE_RECVMMSG
+#endif
+
 #if (0)
 #define WATCH1(s,a) printf(s, a)
 #define WATCH2(s,a,b) printf(s, a, b)
@@ -92,6 +104,221 @@ static void Get_Local_IP(REBREQ *sock)
 	sock->net.local_port = ntohs(sa.sin_port);
 }
 
+static long Send_File(REBREQ *sock, long len, int flags)
+{
+	// Send len bytes of the file at net.file_offset (RSM_SENDFILE mode).
+	// Returns the number of bytes sent or -1 with the error in GET_ERROR.
+	// On Linux the data go from the page cache to the socket directly,
+	// elsewhere they are read in MAX_TRANSFER chunks.
+	long result;
+#ifdef USE_SENDFILE
+	// There is no MSG_NOSIGNAL for sendfile, so SIGPIPE is blocked
+	// during the call and a pending one is consumed on EPIPE.
+	off_t offset = (off_t)sock->net.file_offset;
+	sigset_t pipe_set, old_set;
+	sigemptyset(&pipe_set);
+	sigaddset(&pipe_set, SIGPIPE);
+	sigprocmask(SIG_BLOCK, &pipe_set, &old_set);
+	result = (long)sendfile(sock->socket, sock->net.file_id, &offset, (size_t)len);
+	if (result < 0 && errno == EPIPE) {
+		struct timespec zero = {0, 0};
+		sigtimedwait(&pipe_set, NULL, &zero);
+		errno = EPIPE;
+	}
+	sigprocmask(SIG_SETMASK, &old_set, NULL);
+#else
+	char buf[MAX_TRANSFER];
+	len = MIN(len, MAX_TRANSFER);
+#ifdef TO_WINDOWS
+	{
+		DWORD got = 0;
+		OVERLAPPED ov = {0};
+		ov.Offset = (DWORD)sock->net.file_offset;
+		ov.OffsetHigh = (DWORD)(sock->net.file_offset >> 32);
+		if (!ReadFile(sock->net.file_handle, buf, (DWORD)len, &got, &ov)) {
+			WSASetLastError(GetLastError());
+			return -1;
+		}
+		result = (long)got;
+	}
+#else
+	result = (long)pread(sock->net.file_id, buf, (size_t)len, (off_t)sock->net.file_offset);
+#endif
+	if (result > 0) result = send(sock->socket, buf, result, flags);
+#endif
+	if (result == 0 && len > 0) {
+		// The file is shorter than expected (truncated meanwhile):
+		sock->length = sock->actual;
+	}
+	if (result > 0) sock->net.file_offset += result;
+	return result;
+}
+
+static long Send_Gather(REBREQ *sock, int flags, SOCKAI *addr)
+{
+	// Send the REBIOV list (RSM_GATHER mode) from the sock->actual position.
+	// Up to MAX_GATHER buffers are passed to one sendmsg call.
+	// The addr is used for UDP only: the list must be sent as one
+	// datagram, so a list which does not fit one call is an error.
+	// Returns the number of bytes sent or -1 with the error in GET_ERROR.
+	REBIOV *io = (REBIOV *)sock->data;
+	u32 skip = sock->actual;
+	int n = 0;
+#ifdef TO_WINDOWS
+	// The old winsock API has no gather send, so the buffers
+	// are collected into one MAX_TRANSFER chunk:
+	char buf[MAX_TRANSFER];
+	u32 len;
+#else
+	struct iovec bufs[MAX_GATHER];
+	struct msghdr msg;
+#endif
+
+	// Skip buffers which were already sent:
+	for (; io->data && skip >= io->length; io++) skip -= io->length;
+
+#ifdef TO_WINDOWS
+	if (addr) {
+		REBIOV *rest = io;
+		for (len = 0; rest->data; rest++) len += rest->length;
+		if (len - skip > MAX_TRANSFER) {
+			WSASetLastError(NE_MSGSIZE);
+			return -1;
+		}
+	}
+	for (; io->data && n < MAX_TRANSFER; io++) {
+		len = MIN(io->length - skip, (u32)(MAX_TRANSFER - n));
+		memcpy(buf + n, io->data + skip, len);
+		n += len;
+		skip = 0;
+	}
+	if (n == 0) return 0;
+	if (addr) return sendto(sock->socket, buf, n, flags, (struct sockaddr *)addr, sizeof(*addr));
+	return send(sock->socket, buf, n, flags);
+#else
+	for (; io->data && n < MAX_GATHER; io++, n++) {
+		bufs[n].iov_base = io->data + skip;
+		bufs[n].iov_len = io->length - skip;
+		skip = 0;
+	}
+	if (n == 0) return 0;
+	if (addr && io->data) {
+		errno = NE_MSGSIZE;
+		return -1;
+	}
+
+	memset(&msg, 0, sizeof(msg));
+	msg.msg_iov = bufs;
+	msg.msg_iovlen = n;
+	if (addr) {
+		msg.msg_name = addr;
+		msg.msg_namelen = sizeof(*addr);
+	}
+	return (long)sendmsg(sock->socket, &msg, flags);
+#endif
+}
+
+static long Receive_Batch(REBREQ *sock)
+{
+	// Receive all waiting datagrams (up to NET_BATCH_MAX) into the batch
+	// buffer of the socket (RSM_BATCH mode). Datagrams not yet taken by
+	// the core stay in the buffer. On Linux one recvmmsg call is used.
+	// A datagram longer than NET_BATCH_SLOT is dropped and reported as
+	// an NE_MSGSIZE error (the datagrams before it stay in the buffer).
+	// Returns number of datagrams or -1 with the error in GET_ERROR.
+	REBNETB *batch = (REBNETB *)sock->net.batch;
+	SOCKAI addr[NET_BATCH_MAX];
+	REBOOL truncated = FALSE;
+	int n, i;
+
+	if (!batch) {
+		batch = OS_Make(sizeof(REBNETB));
+		if (!batch) return -1;
+		batch->count = 0;
+		sock->net.batch = batch;
+	}
+	n = batch->count;
+	if (n >= NET_BATCH_MAX) return n;
+
+#ifdef USE_RECVMMSG
+	{
+		struct mmsghdr msgs[NET_BATCH_MAX];
+		struct iovec iov[NET_BATCH_MAX];
+		int got, end;
+
+		memset(msgs, 0, sizeof(msgs));
+		for (i = n; i < NET_BATCH_MAX; i++) {
+			iov[i].iov_base = batch->data[i];
+			iov[i].iov_len = NET_BATCH_SLOT;
+			msgs[i].msg_hdr.msg_iov = &iov[i];
+			msgs[i].msg_hdr.msg_iovlen = 1;
+			msgs[i].msg_hdr.msg_name = &addr[i];
+			msgs[i].msg_hdr.msg_namelen = sizeof(addr[i]);
+		}
+		got = recvmmsg(sock->socket, msgs + n, NET_BATCH_MAX - n, MSG_DONTWAIT, NULL);
+		if (got < 0) return n > 0 ? n : -1;
+		end = n + got;
+		for (i = n; i < end; i++) {
+			if (msgs[i].msg_hdr.msg_flags & MSG_TRUNC) {
+				truncated = TRUE;
+				continue;
+			}
+			if (n < i) memcpy(batch->data[n], batch->data[i], msgs[i].msg_len);
+			batch->info[n].length = msgs[i].msg_len;
+			batch->info[n].remote_ip = addr[i].sin_addr.s_addr;
+			batch->info[n].remote_port = ntohs(addr[i].sin_port);
+			n++;
+		}
+	}
+#else
+	for (i = n; i < NET_BATCH_MAX; i++) {
+		socklen_t addr_len = sizeof(addr[i]);
+		long result;
+#ifdef TO_WINDOWS
+		result = recvfrom(sock->socket, (char*)batch->data[i], NET_BATCH_SLOT, 0,
+						  (struct sockaddr*)&addr[i], &addr_len);
+		if (result < 0 && GET_ERROR == WSAEMSGSIZE) {
+			truncated = TRUE;
+			break;
+		}
+#else
+		struct msghdr msg;
+		struct iovec iov;
+		iov.iov_base = batch->data[i];
+		iov.iov_len = NET_BATCH_SLOT;
+		memset(&msg, 0, sizeof(msg));
+		msg.msg_iov = &iov;
+		msg.msg_iovlen = 1;
+		msg.msg_name = &addr[i];
+		msg.msg_namelen = addr_len;
+		result = recvmsg(sock->socket, &msg, 0);
+		if (result >= 0 && (msg.msg_flags & MSG_TRUNC)) {
+			truncated = TRUE;
+			break;
+		}
+#endif
+		if (result < 0) {
+			if (i > n) break;
+			return n > 0 ? n : -1;
+		}
+		batch->info[i].length = (u32)result;
+		batch->info[i].remote_ip = addr[i].sin_addr.s_addr;
+		batch->info[i].remote_port = ntohs(addr[i].sin_port);
+	}
+	n = i;
+#endif
+	batch->count = n;
+	if (truncated) {
+#ifdef TO_WINDOWS
+		WSASetLastError(NE_MSGSIZE);
+#else
+		errno = NE_MSGSIZE;
+#endif
+		return -1;
+	}
+	return n;
+}
+
 static REBOOL Nonblocking_Mode(SOCKET sock)
 {
 	// Set non-blocking mode. Return TRUE if no error.
@@ -257,6 +484,12 @@ static REBOOL Nonblocking_Mode(SOCKET sock)
 
 		sock->state = 0;  // clear: RSM_OPEN, RSM_CONNECT
 
+		// Free the UDP batch receive buffer:
+		if (GET_FLAG(sock->modes, RST_UDP) && sock->net.batch) {
+			OS_Free(sock->net.batch);
+			sock->net.batch = NULL;
+		}
+
 		// If DNS pending, abort it:
 		if (sock->net.host_info) {  // indicates DNS phase active
 #ifdef HAS_ASYNC_DNS
@@ -460,8 +693,11 @@ static REBOOL Nonblocking_Mode(SOCKET sock)
 
 	SET_FLAG(sock->state, mode);
 
-	// Limit size of transfer:
-	len = MIN(sock->length - sock->actual, MAX_TRANSFER);
+	// Limit size of a send from memory (receive is limited by the
+	// adaptive buffer, the kernel limits sendfile and gather itself):
+	len = sock->length - sock->actual;
+	if (mode == RSM_SEND && !GET_FLAG(sock->state, RSM_SENDFILE) && !GET_FLAG(sock->state, RSM_GATHER))
+		len = MIN(len, MAX_TRANSFER);
 
 	if (mode == RSM_SEND) {
 		// If host is no longer connected:
@@ -473,7 +709,17 @@ static REBOOL Nonblocking_Mode(SOCKET sock)
 		//i64 tm = OS_Delta_Time(0, 0);
 
 		//WATCH1("sendto data: %x\n", sock->data);
-		if (GET_FLAG(sock->modes, RST_UDP)) {
+		if (GET_FLAG(sock->state, RSM_SENDFILE)) {
+			result = Send_File(sock, len, flags);
+		}
+		else if (GET_FLAG(sock->state, RSM_GATHER)) {
+			if (GET_FLAG(sock->modes, RST_UDP)) {
+				Set_Addr(&remote_addr, sock->net.remote_ip, sock->net.remote_port);
+				result = Send_Gather(sock, flags, &remote_addr);
+			}
+			else result = Send_Gather(sock, flags, NULL);
+		}
+		else if (GET_FLAG(sock->modes, RST_UDP)) {
 			Set_Addr(&remote_addr, sock->net.remote_ip, sock->net.remote_port);
 			result = sendto(sock->socket, (const char*)sock->data, len, flags,
 				(struct sockaddr*)&remote_addr, addr_len);
@@ -488,9 +734,12 @@ static REBOOL Nonblocking_Mode(SOCKET sock)
 		//WATCH2("send() len: %d actual: %d\n", len, result);
 
 		if (result >= 0) {
-			sock->data += result;
+			if (!GET_FLAG(sock->state, RSM_SENDFILE) && !GET_FLAG(sock->state, RSM_GATHER))
+				sock->data += result;
 			sock->actual += result;
 			if (sock->actual >= sock->length) {
+				CLR_FLAG(sock->state, RSM_SENDFILE);
+				CLR_FLAG(sock->state, RSM_GATHER);
 				OS_Signal_Device(sock, EVT_WROTE);
 				return DR_DONE;
 			}
@@ -499,6 +748,15 @@ static REBOOL Nonblocking_Mode(SOCKET sock)
 		}
 		// if (result < 0) ...
 	}
+	else if (GET_FLAG(sock->state, RSM_BATCH)) {
+		result = Receive_Batch(sock);
+		if (result > 0) {
+			sock->actual = 0;
+			OS_Signal_Device(sock, EVT_READ);
+			return DR_DONE;
+		}
+		// if (result < 0) ...
+	}
 	else {
 		result = recvfrom(sock->socket, (char*)sock->data, len, 0,
 						  (struct sockaddr*)&remote_addr, &addr_len);
@@ -90,6 +90,7 @@ enum test_cmd_words {
 	CMD_echo,
 	CMD_path,
 	CMD_stru,
+	CMD_xchar,
 };
 char *RX_Spec =
 	"REBOL [\n"
@@ -97,7 +98,7 @@ char *RX_Spec =
 		"Name: ext-test\n"
 		"Type: module\n"
 		"Options: [boot extension]\n"
-		"Exports: [xtest]\n"
+		"Exports: [xtest xchar]\n"
 	"]\n"
 	"init-words:   command [words [block!]]\n"
 	"xarg0:  command [{return zero}]\n"
@@ -122,6 +123,7 @@ char *RX_Spec =
 	"echo:   command [{return the input value} value]\n"
 	"path:   command [{converts Rebol file to OS file as string or binary} f [file!] /full {full path} /utf8]\n"
 	"stru:   command [{test struct passing} val [struct!]]\n"
+	"xchar:  command [{set char in string at index} str [string!] index [integer!] char [char!]]\n"
 
 	"init-words [id data length] protect/hide 'init-words\n"
 	"a: b: c: h: x: y: none\n"
@@ -476,6 +478,10 @@ RXIEXT int RX_Call(int cmd, RXIFRM *frm, void *ctx) {
 		}
 		return RXR_VALUE;
 	}
+	case CMD_xchar: //command [{set char in string at index} str [string!] index [integer!] char [char!]]
+		// writes through the library API (string may share data with its prototype)
+		RL_SET_CHAR(RXA_SERIES(frm, 1), RXA_INDEX(frm, 1) + (u32)RXA_INT64(frm, 2) - 1, RXA_CHAR(frm, 3));
+		return RXR_VALUE;
 	case CMD_init: // init words
 		x_arg_words = RL_MAP_WORDS(RXA_SERIES(frm,1));
 		return RXR_TRUE;
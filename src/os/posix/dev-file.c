@@ -171,6 +171,8 @@ static REBOOL Seek_File_64(REBREQ *file)
 	return 1;
 }
 
+static void Set_File_Info(REBREQ *file, struct stat *info);
+
 static int Get_File_Info(REBREQ *file)
 {
 	struct stat info;
@@ -206,32 +208,35 @@ use_stat:
 		file->error = errno;
 		return DR_ERROR;
 	}
+	Set_File_Info(file, &info);
+	return DR_DONE;
+}
 
-	if (S_ISDIR(info.st_mode)) {
+static void Set_File_Info(REBREQ *file, struct stat *info)
+{
+	if (S_ISDIR(info->st_mode)) {
 		SET_FLAG(file->modes, RFM_DIR);
 		file->file.size = MIN_I64; // using MIN_I64 to notify, that size should be reported as NONE
 	}
 	else {
 		CLR_FLAG(file->modes, RFM_DIR);
-		file->file.size = info.st_size;
+		file->file.size = info->st_size;
 	}
 #ifdef TO_MACOS
-	file->file.modified_time.l = (i32)(info.st_mtimespec.tv_sec);
-	file->file.accessed_time.l = (i32)(info.st_atimespec.tv_sec);
-	file->file.created_time.l  = (i32)(info.st_birthtimespec.tv_sec);
-	file->file.modified_time.h = (i32)(info.st_mtimespec.tv_nsec);
-	file->file.accessed_time.h = (i32)(info.st_atimespec.tv_nsec);
-	file->file.created_time.h  = (i32)(info.st_birthtimespec.tv_nsec);
+	file->file.modified_time.l = (i32)(info->st_mtimespec.tv_sec);
+	file->file.accessed_time.l = (i32)(info->st_atimespec.tv_sec);
+	file->file.created_time.l  = (i32)(info->st_birthtimespec.tv_sec);
+	file->file.modified_time.h = (i32)(info->st_mtimespec.tv_nsec);
+	file->file.accessed_time.h = (i32)(info->st_atimespec.tv_nsec);
+	file->file.created_time.h  = (i32)(info->st_birthtimespec.tv_nsec);
 #else
-	file->file.modified_time.l = (i32)(info.st_mtim.tv_sec);
-	file->file.accessed_time.l = (i32)(info.st_atim.tv_sec);
-	file->file.modified_time.h = (i32)(info.st_mtim.tv_nsec);
-	file->file.accessed_time.h = (i32)(info.st_atim.tv_nsec);
+	file->file.modified_time.l = (i32)(info->st_mtim.tv_sec);
+	file->file.accessed_time.l = (i32)(info->st_atim.tv_sec);
+	file->file.modified_time.h = (i32)(info->st_mtim.tv_nsec);
+	file->file.accessed_time.h = (i32)(info->st_atim.tv_nsec);
 	// creation time is not available, so use the modification time...
 	file->file.created_time = file->file.modified_time;
 #endif
-
-	return DR_DONE;
 }
 
 
@@ -341,6 +346,19 @@ use_stat:
 	// Line below DOES NOT WORK -- because we need full path.
 	//Get_File_Info(file); // updates modes, size, time
 
+	if (GET_FLAG(dir->modes, RFM_INFO)) {
+		// Stat relative to the open directory, so no full path is needed
+		// and the kernel does not have to resolve it again per entry:
+		struct stat info;
+		if (fstatat(dirfd(h), cp, &info, AT_SYMLINK_NOFOLLOW) == 0) {
+			Set_File_Info(file, &info);
+		} else {
+			// broken link or entry removed meanwhile; keep the name only
+			file->file.size = MIN_I64;
+			CLEARS(&file->file.modified_time);
+		}
+	}
+
 	return DR_DONE;
 }
 
@@ -75,6 +75,12 @@
 #include <dlfcn.h>
 #endif
 
+#ifndef NO_POSIX_SPAWN
+#include <spawn.h>
+#define USE_POSIX_SPAWN
+extern char **environ;
+#endif
+
 // Semaphore lock to sync sub-task launch:
 static void *Task_Ready;
 
@@ -873,6 +879,20 @@ static inline REBOOL Open_Pipe_Fails(int pipefd[2]) {
 }
 
 
+
+#ifdef USE_POSIX_SPAWN
+//Helper function for OS_Create_Process:
+//Queues redirection of the child's target descriptor either to an already
+//opened pipe end or to a freshly opened file. Does nothing for inherited I/O.
+static int Spawn_Redirect(posix_spawn_file_actions_t *actions, int pipe_fd, const char *path, int oflag, int target) {
+	if (pipe_fd >= 0)
+		return posix_spawn_file_actions_adddup2(actions, pipe_fd, target);
+	if (path != NULL)
+		return posix_spawn_file_actions_addopen(actions, target, path, oflag, 0666);
+	return 0;
+}
+#endif
+
 /***********************************************************************
 **
 */	OS_API int OS_Create_Process(REBCHR *call, int argc, REBCHR* argv[], u32 flags, u64 *pid, int *exit_code, u32 input_type, void *input, u32 input_len, u32 output_type, void **output, u32 *output_len, u32 err_type, void **err, u32 *err_len)
@@ -944,11 +964,60 @@ static inline REBOOL Open_Pipe_Fails(int pipefd[2]) {
 		}
 	}
 
+#ifdef USE_POSIX_SPAWN
+	// posix_spawn does not copy the parent's page tables (glibc uses
+	// CLONE_VM|CLONE_VFORK), which matters with a large interpreter heap.
+	// Exec failures are returned directly, so the info pipe is not needed.
+	{
+		posix_spawn_file_actions_t actions;
+		const char **argv_new = NULL;
+		char *const *args = (char *const *)argv;
+		pid_t child = 0;
+
+		ret = posix_spawn_file_actions_init(&actions);
+		if (!ret) {
+			ret = Spawn_Redirect(&actions, stdin_pipe[R],
+				input_type == FILE_TYPE ? (char *)input : (input_type == NONE_TYPE ? "/dev/null" : NULL),
+				O_RDONLY, STDIN_FILENO);
+			if (!ret) ret = Spawn_Redirect(&actions, stdout_pipe[W],
+				output_type == FILE_TYPE ? (char *)*output : (output_type == NONE_TYPE ? "/dev/null" : NULL),
+				O_CREAT|O_WRONLY, STDOUT_FILENO);
+			if (!ret) ret = Spawn_Redirect(&actions, stderr_pipe[W],
+				err_type == FILE_TYPE ? (char *)*err : (err_type == NONE_TYPE ? "/dev/null" : NULL),
+				O_CREAT|O_WRONLY, STDERR_FILENO);
+
+			if (!ret && flag_shell) {
+				const char *sh = getenv("SHELL");
+				if (sh == NULL) {
+					sh = "/bin/sh"; // if $SHELL is not defined
+				}
+				argv_new = OS_Make((argc + 3) * sizeof(char*));
+				argv_new[0] = sh;
+				argv_new[1] = "-c";
+				memcpy(&argv_new[2], argv, argc * sizeof(argv[0]));
+				argv_new[argc + 2] = NULL;
+				args = (char *const *)argv_new;
+			}
+			if (!ret) ret = posix_spawnp(&child, args[0], &actions, NULL, args, environ);
+			posix_spawn_file_actions_destroy(&actions);
+		}
+		if (argv_new != NULL) OS_Free(argv_new);
+
+		if (ret) {
+			errno = ret;
+			fpid = -1;
+		} else {
+			fpid = child;
+		}
+		ret = 0;
+	}
+#else
 	if (Open_Pipe_Fails(info_pipe)) {
 		goto info_pipe_err;
 	}
 
 	fpid = fork();
+#endif
 	if (fpid == 0) {
 		/* child */
 		if (input_type == STRING_TYPE
@@ -1061,7 +1130,7 @@ child_error:
 		exit(EXIT_FAILURE); /* get here only when exec fails */
 	} else if (fpid > 0) {
 		/* parent */
-#define BUF_SIZE_CHUNK 4096
+#define BUF_SIZE_CHUNK 4096 // initial capture buffer; doubled as it fills
 		nfds_t nfds = 0;
 		struct pollfd pfds[4];
 		pid_t xpid;
@@ -1224,9 +1293,12 @@ child_error:
 						//printf("POLLIN: %d bytes\n", nbytes);
 						*offset += nbytes;
 						if (*offset >= *size) {
-							*size += BUF_SIZE_CHUNK;
-							*buffer = realloc(*buffer, *size * sizeof((*buffer)[0]));
-							if (*buffer == NULL) goto kill;
+							// Grow geometrically so capturing large output
+							// stays linear instead of quadratic:
+							char *grown = realloc(*buffer, *size * 2 * sizeof((*buffer)[0]));
+							if (grown == NULL) goto kill;
+							*buffer = grown;
+							*size *= 2;
 						}
 					} while (nbytes == to_read);
 				} else if (pfds[i].revents & POLLHUP) {
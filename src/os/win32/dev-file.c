@@ -168,6 +168,17 @@ static BOOL Seek_File_64(REBREQ *file)
 	COPY_STR(file->file.path, info.cFileName, MAX_FILE_NAME);
 	file->file.size = ((i64)info.nFileSizeHigh << 32) + info.nFileSizeLow;
 
+	if (GET_FLAG(dir->modes, RFM_INFO)) {
+		// The find data already holds the times, so no extra call is needed:
+		if (GET_FLAG(file->modes, RFM_DIR)) file->file.size = MIN_I64;
+		file->file.modified_time.l = info.ftLastWriteTime.dwLowDateTime;
+		file->file.modified_time.h = info.ftLastWriteTime.dwHighDateTime;
+		file->file.accessed_time.l = info.ftLastAccessTime.dwLowDateTime;
+		file->file.accessed_time.h = info.ftLastAccessTime.dwHighDateTime;
+		file->file.created_time.l  = info.ftCreationTime.dwLowDateTime;
+		file->file.created_time.h  = info.ftCreationTime.dwHighDateTime;
+	}
+
 	return DR_DONE;
 }
 